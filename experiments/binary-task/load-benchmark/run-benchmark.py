@@ -0,0 +1,70 @@
+#! /usr/bin/env python3
+
+"""
+Compare the time for loading tasks from translator output and from the
+binary task format.
+
+Usage: run-benchmark.py [--build BUILD] [--runs N] OUTPUT.SAS [...]
+
+For each task, the script writes a binary task next to it with
+"downward --write-binary-task" and then runs the search component N times
+on each format. We measure the time until "done reading input!" is
+logged. The search itself is stopped immediately by max_time=0.
+"""
+
+import argparse
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(os.path.dirname(DIR)))
+DONE_READING_REGEX = re.compile(r"^\[t=(.+)s, (\d+) KB\] done reading input!$", re.M)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("tasks", nargs="+", help="translator output files")
+    parser.add_argument("--build", default="release", help="build name (default: %(default)s)")
+    parser.add_argument("--runs", type=int, default=5, help="runs per task and format (default: %(default)s)")
+    return parser.parse_args()
+
+
+def run_planner(planner, args, task):
+    with open(task, "rb") as input_file:
+        return subprocess.run(
+            [planner] + args, stdin=input_file, stdout=subprocess.PIPE,
+            universal_newlines=True).stdout
+
+
+def measure_loading(planner, task, runs):
+    times = []
+    for _ in range(runs):
+        output = run_planner(planner, ["--search", "astar(blind(), max_time=0)"], task)
+        match = DONE_READING_REGEX.search(output)
+        if not match:
+            sys.exit("could not find load time for {}".format(task))
+        times.append(float(match.group(1)))
+        memory = int(match.group(2))
+    return statistics.median(times), memory
+
+
+def main():
+    args = parse_args()
+    planner = os.path.join(REPO, "builds", args.build, "bin", "downward")
+    print("{:40} {:>12} {:>12} {:>10} {:>10} {:>8}".format(
+        "task", "text [s]", "binary [s]", "text [KB]", "bin [KB]", "speedup"))
+    for task in args.tasks:
+        binary_task = os.path.splitext(task)[0] + ".bin"
+        run_planner(planner, ["--write-binary-task", binary_task], task)
+        text_time, text_memory = measure_loading(planner, task, args.runs)
+        binary_time, binary_memory = measure_loading(planner, binary_task, args.runs)
+        print("{:40} {:12.6f} {:12.6f} {:10d} {:10d} {:8.1f}".format(
+            task, text_time, binary_time, text_memory, binary_memory,
+            text_time / max(binary_time, 1e-9)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_state_registry.h"
+
+#include "algorithms/int_packer.h"
+#include "utils/logging.h"
+
+using namespace std;
+
+/*
+  The registry only needs the logger for print_statistics(). Defining it
+  here avoids linking the option parser, which utils/logging.cc needs.
+*/
+namespace utils {
+Log g_log;
+}
+
+
+static void benchmark(const string &desc, int num_threads,
+                      const function<void(int)> &func) {
+    cout << "Running " << desc << " with " << num_threads << " threads:"
+         << flush;
+
+    /*
+      We measure wall-clock time because clock() sums up the CPU time of
+      all threads.
+    */
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(func, i);
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    double duration = chrono::duration<double>(end - start).count();
+    cout << " " << duration << "s" << endl;
+}
+
+
+static vector<PackedStateBin> generate_states(
+    const int_packer::IntPacker &packer, int num_variables, int domain_size,
+    int num_states) {
+    int bins_per_state = packer.get_num_bins();
+    vector<PackedStateBin> states(num_states * bins_per_state, 0);
+    mt19937 rng(2020);
+    uniform_int_distribution<int> dist(0, domain_size - 1);
+    for (int i = 0; i < num_states; ++i) {
+        for (int var = 0; var < num_variables; ++var) {
+            packer.set(&states[i * bins_per_state], var, dist(rng));
+        }
+    }
+    return states;
+}
+
+
+/*
+  Let all threads insert the same states at the same time, many of
+  which are duplicates, and check that every state is registered exactly
+  once, that all threads receive the same ID for it and that the IDs
+  refer to the right data. Return the number of errors.
+*/
+static int check(int num_threads) {
+    const int NUM_VARIABLES = 8;
+    const int DOMAIN_SIZE = 3;
+    const int NUM_STATES = 20000;
+
+    int_packer::IntPacker packer(vector<int>(NUM_VARIABLES, DOMAIN_SIZE));
+    int bins_per_state = packer.get_num_bins();
+    vector<PackedStateBin> states =
+        generate_states(packer, NUM_VARIABLES, DOMAIN_SIZE, NUM_STATES);
+
+    // Use few shards so that threads compete for the same locks.
+    ConcurrentStateRegistry registry(packer, 2);
+    vector<vector<StateID>> ids(
+        num_threads, vector<StateID>(NUM_STATES, StateID::no_state));
+    vector<vector<bool>> is_new(num_threads, vector<bool>(NUM_STATES));
+    benchmark("check concurrent insertions", num_threads, [&](int t) {
+                  for (int i = 0; i < NUM_STATES; ++i) {
+                      pair<StateID, bool> result = registry.insert_state(
+                          &states[i * bins_per_state]);
+                      ids[t][i] = result.first;
+                      is_new[t][i] = result.second;
+                  }
+              });
+
+    int num_errors = 0;
+    vector<StateID> first_ids;
+    for (int i = 0; i < NUM_STATES; ++i) {
+        const PackedStateBin *state = &states[i * bins_per_state];
+        const PackedStateBin *buffer = registry.lookup_buffer(ids[0][i]);
+        if (memcmp(buffer, state, bins_per_state * sizeof(PackedStateBin))) {
+            cerr << "State " << i << ": lookup returned wrong data." << endl;
+            ++num_errors;
+        }
+        int num_new = 0;
+        for (int t = 0; t < num_threads; ++t) {
+            if (ids[t][i] != ids[0][i]) {
+                cerr << "State " << i << ": threads received different IDs."
+                     << endl;
+                ++num_errors;
+            }
+            num_new += is_new[t][i];
+        }
+        if (num_new) {
+            first_ids.push_back(ids[0][i]);
+        }
+        if (num_new > 1) {
+            cerr << "State " << i << ": registered " << num_new << " times."
+                 << endl;
+            ++num_errors;
+        }
+    }
+    sort(first_ids.begin(), first_ids.end(),
+         [](StateID id1, StateID id2) {return id1.hash() < id2.hash();});
+    if (adjacent_find(first_ids.begin(), first_ids.end()) != first_ids.end()) {
+        cerr << "Different states received the same ID." << endl;
+        ++num_errors;
+    }
+    if (registry.size() != static_cast<int>(first_ids.size())) {
+        cerr << "Registry contains " << registry.size() << " states, but "
+             << first_ids.size() << " were registered." << endl;
+        ++num_errors;
+    }
+    cout << "Registered states: " << registry.size() << ", errors: "
+         << num_errors << endl;
+    return num_errors;
+}
+
+
+int main(int argc, char **argv) {
+    const int NUM_VARIABLES = 40;
+    const int DOMAIN_SIZE = 10;
+    const int NUM_STATES = 2000000;
+    const int SHARDS_PER_THREAD = 16;
+
+    /*
+      With --check, only test the registry on a small number of states
+      instead of measuring its performance.
+    */
+    bool check_only = argc >= 2 && strcmp(argv[1], "--check") == 0;
+    if (check_only) {
+        --argc;
+        ++argv;
+    }
+
+    int max_num_threads = thread::hardware_concurrency();
+    if (argc == 2) {
+        max_num_threads = atoi(argv[1]);
+    }
+    max_num_threads = max(max_num_threads, 1);
+
+    if (check_only) {
+        // Use at least two threads, even on a single core.
+        return check(max(max_num_threads, 2)) == 0 ? 0 : 1;
+    }
+
+    int_packer::IntPacker packer(vector<int>(NUM_VARIABLES, DOMAIN_SIZE));
+    int bins_per_state = packer.get_num_bins();
+
+    cout << "Generating " << NUM_STATES << " random states with "
+         << bins_per_state << " bins each." << endl;
+    vector<PackedStateBin> states =
+        generate_states(packer, NUM_VARIABLES, DOMAIN_SIZE, NUM_STATES);
+
+    for (int num_threads = 1; num_threads <= max_num_threads; num_threads *= 2) {
+        cout << endl;
+        ConcurrentStateRegistry registry(packer, num_threads * SHARDS_PER_THREAD);
+        vector<StateID> ids(NUM_STATES, StateID::no_state);
+
+        /*
+          Thread t handles the states i with i % num_threads == t. In the
+          second pass, every thread inserts states that another thread
+          already registered, which measures duplicate detection.
+        */
+        benchmark("insert new states", num_threads, [&](int t) {
+                      for (int i = t; i < NUM_STATES; i += num_threads) {
+                          ids[i] = registry.insert_state(
+                              &states[i * bins_per_state]).first;
+                      }
+                  });
+        benchmark("insert duplicate states", num_threads, [&](int t) {
+                      int offset = (t + 1) % num_threads;
+                      for (int i = offset; i < NUM_STATES; i += num_threads) {
+                          if (registry.insert_state(
+                                  &states[i * bins_per_state]).first != ids[i]) {
+                              cerr << "Duplicate received a new ID." << endl;
+                              abort();
+                          }
+                      }
+                  });
+        benchmark("look up states", num_threads, [&](int t) {
+                      for (int i = t; i < NUM_STATES; i += num_threads) {
+                          const PackedStateBin *buffer =
+                              registry.lookup_buffer(ids[i]);
+                          if (packer.get(buffer, 0) !=
+                              packer.get(&states[i * bins_per_state], 0)) {
+                              cerr << "Lookup returned wrong state." << endl;
+                              abort();
+                          }
+                      }
+                  });
+        cout << "Registered states: " << registry.size()
+             << ", shards: " << registry.get_num_shards() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#! /usr/bin/env python3
+
+"""
+Compare the tree and flat successor generators.
+
+Usage: run-benchmark.py [--build BUILD] [--runs N] [--search SEARCH] OUTPUT.SAS [...]
+
+For each task, the script runs the search N times with
+successor_generator=TREE and successor_generator=FLAT and reports the
+median search time and the number of generated states per second. The
+search configuration must contain the placeholder {generator}.
+Successor generation takes a larger share of the time for cheap
+heuristics, so the default is A* with the blind heuristic.
+"""
+
+import argparse
+import os
+import re
+import statistics
+import subprocess
+import sys
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(os.path.dirname(DIR)))
+SEARCH_TIME_REGEX = re.compile(r"\] Search time: (.+)s$", re.M)
+GENERATED_REGEX = re.compile(r"\] Generated (\d+) state\(s\)\.$", re.M)
+GENERATORS = ["TREE", "FLAT"]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("tasks", nargs="+", help="translator output files")
+    parser.add_argument("--build", default="release", help="build name (default: %(default)s)")
+    parser.add_argument("--runs", type=int, default=3, help="runs per task and generator (default: %(default)s)")
+    parser.add_argument(
+        "--search", default="astar(blind(), successor_generator={generator})",
+        help="search configuration (default: %(default)s)")
+    return parser.parse_args()
+
+
+def run_search(planner, search, task):
+    with open(task) as input_file:
+        output = subprocess.run(
+            [planner, "--search", search], stdin=input_file,
+            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    search_time = SEARCH_TIME_REGEX.search(output)
+    generated = GENERATED_REGEX.search(output)
+    if not search_time or not generated:
+        sys.exit("search failed for {}: {}".format(task, search))
+    return float(search_time.group(1)), int(generated.group(1))
+
+
+def main():
+    args = parse_args()
+    planner = os.path.join(REPO, "builds", args.build, "bin", "downward")
+    print("{:40} {:>6} {:>12} {:>12} {:>14}".format(
+        "task", "gen", "generated", "time [s]", "states/s"))
+    for task in args.tasks:
+        for generator in GENERATORS:
+            search = args.search.format(generator=generator)
+            results = [run_search(planner, search, task) for _ in range(args.runs)]
+            time = statistics.median(result[0] for result in results)
+            generated = results[0][1]
+            print("{:40} {:>6} {:12d} {:12.4f} {:14.0f}".format(
+                task, generator, generated, time, generated / max(time, 1e-9)))
+
+
+if __name__ == "__main__":
+    main()
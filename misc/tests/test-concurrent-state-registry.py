@@ -0,0 +1,22 @@
+import os
+import subprocess
+
+import pytest
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(os.path.dirname(DIR))
+BENCHMARK_DIR = os.path.join(
+    REPO, "experiments", "concurrent-registry", "registry-microbenchmark")
+
+
+def setup_module(module):
+    subprocess.check_call(["make", "all"], cwd=BENCHMARK_DIR)
+
+
+# The debug binary keeps the assertions of the registry enabled.
+@pytest.mark.parametrize("binary", ["benchmark", "benchmark-debug"])
+@pytest.mark.parametrize("num_threads", [2, 8])
+def test_concurrent_insertions(binary, num_threads):
+    subprocess.check_call(
+        [os.path.join(BENCHMARK_DIR, binary), "--check", str(num_threads)],
+        cwd=BENCHMARK_DIR)
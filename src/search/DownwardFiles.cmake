@@ -75,12 +75,13 @@ fast_downward_plugin(
         search_progress
         search_space
         search_statistics
+        search_statistics_stream
         state_id
         state_registry
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES TREE_COMPRESSION
     CORE_PLUGIN
 )
 
@@ -117,12 +118,14 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/profiling
         utils/rng
         utils/rng_options
         utils/strings
         utils/system
         utils/system_unix
         utils/system_windows
+        utils/thread_pool
         utils/timer
     CORE_PLUGIN
 )
@@ -141,6 +144,13 @@ fast_downward_plugin(
         open_lists/best_first_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open list that stores entries in buckets indexed by one or two evaluator values"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME EPSILON_GREEDY_OPEN_LIST
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -217,6 +227,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME MPSC_QUEUE
+    HELP "Lock-free queue with multiple producers and a single consumer"
+    SOURCES
+        algorithms/mpsc_queue
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME ORDERED_SET
     HELP "Set of elements ordered by insertion time"
@@ -241,6 +259,23 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME TREE_COMPRESSION
+    HELP "Compact storage of similar fixed-size arrays in a shared tree of nodes"
+    SOURCES
+        algorithms/tree_compression
+    DEPENDS INT_HASH_SET SEGMENTED_VECTOR
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME CONCURRENT_STATE_REGISTRY
+    HELP "State registry that supports concurrent insertions and lookups"
+    SOURCES
+        concurrent_state_registry
+    DEPENDS INT_HASH_SET INT_PACKER SEGMENTED_VECTOR
+)
+
 fast_downward_plugin(
     NAME EVALUATORS_PLUGIN_GROUP
     HELP "Plugin group for basic evaluators"
@@ -434,6 +469,22 @@ fast_downward_plugin(
         search_engines/iterated_search
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_ASTAR_SEARCH
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/parallel_astar_search
+    DEPENDS MPSC_QUEUE SEARCH_COMMON SUCCESSOR_GENERATOR
+)
+
+fast_downward_plugin(
+    NAME EXTERNAL_ASTAR_SEARCH
+    HELP "External A* search with delayed duplicate detection"
+    SOURCES
+        search_engines/external_astar_search
+    DEPENDS SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME LAZY_SEARCH
     HELP "Lazy search algorithm"
@@ -457,6 +508,7 @@ fast_downward_plugin(
     HELP "The base class for relaxation heuristics"
     SOURCES
         heuristics/array_pool
+        heuristics/batched_relaxed_exploration
         heuristics/relaxation_heuristic
     DEPENDENCY_ONLY
 )
@@ -516,12 +568,21 @@ fast_downward_plugin(
         heuristics/goal_count_heuristic
 )
 
+fast_downward_plugin(
+    NAME HM_TABLE
+    HELP "Flat table of h^m values"
+    SOURCES
+        heuristics/hm_table
+    DEPENDS TASK_PROPERTIES
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME HM_HEURISTIC
     HELP "The h^m heuristic"
     SOURCES
         heuristics/hm_heuristic
-    DEPENDS TASK_PROPERTIES
+    DEPENDS HM_TABLE TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -545,6 +606,7 @@ fast_downward_plugin(
     NAME CORE_TASKS
     HELP "Core task transformations"
     SOURCES
+        tasks/binary_root_task
         tasks/cost_adapted_task
         tasks/delegating_task
         tasks/root_task
@@ -752,7 +814,7 @@ fast_downward_plugin(
         potentials/mutex_based_potential_heuristics
         potentials/mutexes
         potentials/util
-    DEPENDS LP_SOLVER SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS HM_TABLE LP_SOLVER SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -57,6 +57,12 @@ public:
         return (buffer[bin_index] & read_mask) >> shift;
     }
 
+    void get_location(int &bin_index_, int &shift_, Bin &read_mask_) const {
+        bin_index_ = bin_index;
+        shift_ = shift;
+        read_mask_ = read_mask;
+    }
+
     void set(Bin *buffer, int value) const {
         assert(value >= 0 && value < range);
         Bin &bin = buffer[bin_index];
@@ -81,6 +87,17 @@ void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
 
+void IntPacker::unpack(const Bin *buffer, int *values) const {
+    for (const VariableInfo &var_info : var_infos) {
+        *values++ = var_info.get(buffer);
+    }
+}
+
+void IntPacker::get_location(
+    int var, int &bin_index, int &shift, Bin &read_mask) const {
+    var_infos[var].get_location(bin_index, shift, read_mask);
+}
+
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
@@ -42,6 +42,19 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Write the values of all variables to values, which must have room
+      for them. This is faster than calling get() for every variable.
+    */
+    void unpack(const Bin *buffer, int *values) const;
+
+    /*
+      Return where var is stored: get(buffer, var) is equal to
+      (buffer[bin_index] & read_mask) >> shift. This allows clients to
+      precompute the access to frequently read variables.
+    */
+    void get_location(int var, int &bin_index, int &shift, Bin &read_mask) const;
+
     int get_num_bins() const {return num_bins;}
 };
 }
@@ -0,0 +1,100 @@
+#ifndef ALGORITHMS_MPSC_QUEUE_H
+#define ALGORITHMS_MPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mpsc_queue {
+/*
+  Unbounded lock-free queue with multiple producers and a single consumer.
+
+  Producers push items with a compare-and-swap on the head of a singly
+  linked list. The consumer takes all pending items at once by swapping
+  the head with nullptr, so it never competes with other consumers and
+  the ABA problem cannot occur. Items pushed by the same producer are
+  returned in the order in which they were pushed.
+
+  Usage:
+
+  MPSCQueue<int> queue;
+  // Any thread:
+  queue.push(3);
+  // Only the consumer thread:
+  std::vector<int> items;
+  queue.pop_all(items);
+
+  Pushing allocates one list node per item, so items should be batches
+  of data rather than single small values if throughput matters.
+*/
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        T item;
+        Node *next;
+
+        explicit Node(T &&item)
+            : item(std::move(item)),
+              next(nullptr) {
+        }
+    };
+
+    std::atomic<Node *> head;
+
+public:
+    MPSCQueue()
+        : head(nullptr) {
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    ~MPSCQueue() {
+        Node *node = head.exchange(nullptr);
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    // Safe to call concurrently from any number of threads.
+    void push(T item) {
+        Node *node = new Node(std::move(item));
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+                   node->next, node,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /*
+      Append all pending items to "items" in insertion order. Must only
+      be called by the consumer thread.
+    */
+    void pop_all(std::vector<T> &items) {
+        Node *node = head.exchange(nullptr, std::memory_order_acquire);
+        size_t first_new_item = items.size();
+        while (node) {
+            items.push_back(std::move(node->item));
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+        // The list holds the most recently pushed item first.
+        std::reverse(items.begin() + first_new_item, items.end());
+    }
+
+    /*
+      Return true if no items are pending. The result is only a snapshot
+      if other threads push concurrently.
+    */
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+};
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include "tree_compression.h"
+
+#include "../utils/hash.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace tree_compression {
+// The left subtree of a range of the given size covers its first half.
+static int get_left_size(int size) {
+    return (size + 1) / 2;
+}
+
+int_hash_set::HashType TreeCompressor::NodeHash::hash_node(
+    Value left, Value right) {
+    utils::HashState hash_state;
+    hash_state.feed(left);
+    hash_state.feed(right);
+    return hash_state.get_hash32();
+}
+
+TreeCompressor::TreeCompressor(int array_size)
+    : array_size(array_size),
+      nodes(2),
+      node_set(NodeHash(nodes), NodeEqual(nodes)) {
+    assert(array_size >= 1);
+}
+
+TreeCompressor::Value TreeCompressor::insert_node(Value left, Value right) {
+    Value node[] = {left, right};
+    nodes.push_back(node);
+    pair<int, bool> result = node_set.insert(nodes.size() - 1);
+    if (!result.second) {
+        nodes.pop_back();
+    }
+    return result.first;
+}
+
+bool TreeCompressor::find_node(Value left, Value right, Value &node) const {
+    int id = node_set.find_if(
+        NodeHash::hash_node(left, right),
+        [this, left, right](int other) {
+            return nodes[other][0] == left && nodes[other][1] == right;
+        });
+    if (id == -1) {
+        return false;
+    }
+    node = id;
+    return true;
+}
+
+TreeCompressor::Value TreeCompressor::insert(
+    const Value *values, int size,
+    const Value *reference_values, Value reference_root) {
+    if (reference_values &&
+        equal(values, values + size, reference_values)) {
+        return reference_root;
+    }
+    if (size == 1) {
+        return values[0];
+    }
+    int left_size = get_left_size(size);
+    Value left;
+    Value right;
+    if (reference_values) {
+        const Value *reference_node = nodes[reference_root];
+        left = insert(values, left_size, reference_values, reference_node[0]);
+        right = insert(values + left_size, size - left_size,
+                       reference_values + left_size, reference_node[1]);
+    } else {
+        left = insert(values, left_size, nullptr, 0);
+        right = insert(values + left_size, size - left_size, nullptr, 0);
+    }
+    return insert_node(left, right);
+}
+
+bool TreeCompressor::find(const Value *values, int size, Value &root) const {
+    if (size == 1) {
+        root = values[0];
+        return true;
+    }
+    int left_size = get_left_size(size);
+    Value left;
+    Value right;
+    return find(values, left_size, left) &&
+           find(values + left_size, size - left_size, right) &&
+           find_node(left, right, root);
+}
+
+void TreeCompressor::decompress(Value root, int size, Value *values) const {
+    if (size == 1) {
+        values[0] = root;
+        return;
+    }
+    int left_size = get_left_size(size);
+    const Value *node = nodes[root];
+    decompress(node[0], left_size, values);
+    decompress(node[1], size - left_size, values + left_size);
+}
+
+size_t TreeCompressor::get_memory_in_bytes() const {
+    return nodes.size() * 2 * sizeof(Value) + node_set.get_memory_in_bytes();
+}
+}
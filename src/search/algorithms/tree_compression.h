@@ -0,0 +1,110 @@
+#ifndef ALGORITHMS_TREE_COMPRESSION_H
+#define ALGORITHMS_TREE_COMPRESSION_H
+
+#include "int_hash_set.h"
+#include "segmented_vector.h"
+
+namespace tree_compression {
+/*
+  Tree compression of arrays of a fixed size (Laarman, van de Pol and
+  Weber, "Parallel Recursive State Compression for Free", SPIN 2011).
+
+  An array of n values is represented by a balanced binary tree whose
+  leaves are the values of the array. Every inner node is a pair of
+  references to its children, where the reference of a leaf is its value
+  and the reference of an inner node is its index in a table of nodes.
+  Equal nodes are stored only once, so arrays that agree on a range of
+  values share the subtree for this range, and every array is uniquely
+  identified by the reference of its root. For n = 1, the root reference
+  is the single value itself.
+
+  If most arrays differ from a previously compressed array in only a few
+  values, like the successors of a state in a search, compressing an
+  array only adds the nodes on the paths from the changed leaves to the
+  root. Passing the similar array as a reference to insert() also avoids
+  looking up the unchanged subtrees.
+
+  Node indices and values must fit into 32 bits, so the table can hold
+  at most 2^31 nodes (see IntHashSet).
+*/
+class TreeCompressor {
+public:
+    using Value = unsigned int;
+
+private:
+    struct NodeHash {
+        const segmented_vector::SegmentedArrayVector<Value> &nodes;
+        explicit NodeHash(const segmented_vector::SegmentedArrayVector<Value> &nodes)
+            : nodes(nodes) {
+        }
+
+        static int_hash_set::HashType hash_node(Value left, Value right);
+
+        int_hash_set::HashType operator()(int id) const {
+            return hash_node(nodes[id][0], nodes[id][1]);
+        }
+    };
+
+    struct NodeEqual {
+        const segmented_vector::SegmentedArrayVector<Value> &nodes;
+        explicit NodeEqual(const segmented_vector::SegmentedArrayVector<Value> &nodes)
+            : nodes(nodes) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            return nodes[lhs][0] == nodes[rhs][0] && nodes[lhs][1] == nodes[rhs][1];
+        }
+    };
+
+    const int array_size;
+    // Each node consists of the references to its left and right child.
+    segmented_vector::SegmentedArrayVector<Value> nodes;
+    int_hash_set::IntHashSet<NodeHash, NodeEqual> node_set;
+
+    Value insert_node(Value left, Value right);
+    bool find_node(Value left, Value right, Value &node) const;
+    Value insert(const Value *values, int size,
+                 const Value *reference_values, Value reference_root);
+    bool find(const Value *values, int size, Value &root) const;
+    void decompress(Value root, int size, Value *values) const;
+
+public:
+    explicit TreeCompressor(int array_size);
+
+    // Add the array to the table if necessary and return its root.
+    Value insert(const Value *values) {
+        return insert(values, array_size, nullptr, 0);
+    }
+
+    /*
+      Like insert(values), but reuse the subtrees of the given reference
+      array, which must have been inserted before, for all ranges in
+      which the arrays agree.
+    */
+    Value insert(const Value *values, const Value *reference_values,
+                 Value reference_root) {
+        return insert(values, array_size, reference_values, reference_root);
+    }
+
+    /*
+      If the array has been inserted, store its root in root and return
+      true. Otherwise, return false. Never adds nodes.
+    */
+    bool find(const Value *values, Value &root) const {
+        return find(values, array_size, root);
+    }
+
+    // Write the array with the given root to values.
+    void decompress(Value root, Value *values) const {
+        decompress(root, array_size, values);
+    }
+
+    int get_num_nodes() const {
+        return nodes.size();
+    }
+
+    size_t get_memory_in_bytes() const;
+};
+}
+
+#endif
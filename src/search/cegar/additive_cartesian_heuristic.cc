@@ -5,6 +5,8 @@
 #include "types.h"
 #include "utils.h"
 
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -33,7 +35,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<bool>("use_general_costs"),
         opts.get<PickSplit>("pick"),
         *rng,
-        opts.get<bool>("debug"));
+        opts.get<bool>("debug"),
+        opts.get<int>("threads"));
     return cost_saturation.generate_heuristic_functions(
         opts.get<shared_ptr<AbstractTask>>("transform"));
 }
@@ -41,11 +44,15 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
 AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     const options::Options &opts)
     : Heuristic(opts),
-      heuristic_functions(generate_heuristic_functions(opts)) {
+      heuristic_functions(generate_heuristic_functions(opts)),
+      active_batch_index(-1) {
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    if (active_batch_index != -1) {
+        return batch_h_values[active_batch_index];
+    }
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -62,6 +69,40 @@ int AdditiveCartesianHeuristic::compute_heuristic(const State &state) {
     return sum_h;
 }
 
+void AdditiveCartesianHeuristic::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    int num_states = batch.size();
+    vector<State> states;
+    states.reserve(num_states);
+    for (EvaluationContext *eval_context : batch) {
+        states.push_back(convert_global_state(eval_context->get_state()));
+    }
+
+    batch_h_values.assign(num_states, 0);
+    for (const CartesianHeuristicFunction &function : heuristic_functions) {
+        for (int i = 0; i < num_states; ++i) {
+            int &sum_h = batch_h_values[i];
+            if (sum_h == DEAD_END)
+                continue;
+            int value = function.get_value(states[i]);
+            assert(value >= 0);
+            if (value == INF)
+                sum_h = DEAD_END;
+            else
+                sum_h += value;
+        }
+    }
+
+    results.clear();
+    results.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        active_batch_index = i;
+        results.push_back(compute_result(*batch[i]));
+    }
+    active_batch_index = -1;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Additive CEGAR heuristic",
@@ -143,6 +184,15 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "debug",
         "print debugging output",
         "false");
+    parser.add_option<int>(
+        "threads",
+        "number of threads for refining the abstractions of consecutive "
+        "subtasks concurrently. With more than one thread, each batch of "
+        "abstractions is refined under the costs remaining before the "
+        "batch, and the saturated cost partitioning is computed "
+        "afterwards, so the heuristic can differ from the sequential one.",
+        "1",
+        Bounds("1", "infinity"));
     Heuristic::add_options_to_parser(parser);
     utils::add_rng_options(parser);
     Options opts = parser.parse();
@@ -15,6 +15,14 @@ class CartesianHeuristicFunction;
 class AdditiveCartesianHeuristic : public Heuristic {
     const std::vector<CartesianHeuristicFunction> heuristic_functions;
 
+    /*
+      Heuristic values computed by compute_results for a batch of states
+      and the index of the state that is currently being evaluated in
+      the batch (or -1).
+    */
+    std::vector<int> batch_h_values;
+    int active_batch_index;
+
     int compute_heuristic(const State &state);
 
 protected:
@@ -22,6 +30,14 @@ protected:
 
 public:
     explicit AdditiveCartesianHeuristic(const options::Options &opts);
+
+    /*
+      Look up all states of the batch in one abstraction after the other,
+      so that only one compiled refinement hierarchy is in use at a time.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
 };
 }
 
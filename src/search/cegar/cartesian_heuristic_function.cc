@@ -2,21 +2,94 @@
 
 #include "refinement_hierarchy.h"
 
-#include "../utils/collections.h"
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
 
 using namespace std;
 
 namespace cegar {
-CartesianHeuristicFunction::CartesianHeuristicFunction(
-    unique_ptr<RefinementHierarchy> &&hierarchy,
-    vector<int> &&h_values)
-    : refinement_hierarchy(move(hierarchy)),
-      h_values(move(h_values)) {
+/*
+  Map the values of each variable in the ancestor task to the values in
+  the subtask. The subtasks used for building Cartesian abstractions
+  keep the variables of their ancestors and only map values of single
+  variables, so we can convert one state per ancestor value.
+*/
+static vector<vector<int>> get_value_maps(
+    const TaskProxy &ancestor_task_proxy, const TaskProxy &subtask_proxy) {
+    VariablesProxy variables = ancestor_task_proxy.get_variables();
+    int num_variables = variables.size();
+    assert(static_cast<int>(subtask_proxy.get_variables().size()) == num_variables);
+    int max_domain_size = 0;
+    for (VariableProxy var : variables)
+        max_domain_size = max(max_domain_size, var.get_domain_size());
+
+    vector<vector<int>> value_maps(num_variables);
+    for (int value = 0; value < max_domain_size; ++value) {
+        vector<int> ancestor_values(num_variables);
+        for (VariableProxy var : variables)
+            ancestor_values[var.get_id()] = min(value, var.get_domain_size() - 1);
+        State ancestor_state = ancestor_task_proxy.create_state(move(ancestor_values));
+        State subtask_state = subtask_proxy.convert_ancestor_state(ancestor_state);
+        for (VariableProxy var : variables) {
+            if (value < var.get_domain_size())
+                value_maps[var.get_id()].push_back(subtask_state[var].get_value());
+        }
+    }
+    return value_maps;
 }
 
-int CartesianHeuristicFunction::get_value(const State &state) const {
-    int abstract_state_id = refinement_hierarchy->get_abstract_state_id(state);
-    assert(utils::in_bounds(abstract_state_id, h_values));
-    return h_values[abstract_state_id];
+CartesianHeuristicFunction::CartesianHeuristicFunction(
+    const RefinementHierarchy &hierarchy,
+    const vector<int> &h_values,
+    const AbstractTask &ancestor_task) {
+    TaskProxy ancestor_task_proxy(ancestor_task);
+    VariablesProxy variables = ancestor_task_proxy.get_variables();
+    vector<vector<int>> value_maps = get_value_maps(
+        ancestor_task_proxy, TaskProxy(*hierarchy.get_task()));
+
+    /*
+      Nodes receive their positions when they are first reached and are
+      written in the same order, which yields a breadth-first layout.
+    */
+    unordered_map<NodeID, int> positions;
+    deque<NodeID> queue;
+    int num_entries = 0;
+    auto get_entry = [&](NodeID node_id) {
+            const Node &node = hierarchy.get_node(node_id);
+            if (!node.is_split()) {
+                int h = h_values[node.get_state_id()];
+                assert(h >= 0);
+                return -h - 1;
+            }
+            auto it = positions.find(node_id);
+            if (it != positions.end())
+                return it->second;
+            int position = num_entries;
+            num_entries += 1 + variables[node.get_var()].get_domain_size();
+            positions[node_id] = position;
+            queue.push_back(node_id);
+            return position;
+        };
+
+    root_entry = get_entry(0);
+    while (!queue.empty()) {
+        NodeID node_id = queue.front();
+        queue.pop_front();
+        assert(positions[node_id] == static_cast<int>(nodes.size()));
+        int var = hierarchy.get_node(node_id).get_var();
+        nodes.push_back(var);
+        for (int subtask_value : value_maps[var]) {
+            // Skip helper nodes and repeated splits of the same variable.
+            NodeID child_id = node_id;
+            while (hierarchy.get_node(child_id).is_split() &&
+                   hierarchy.get_node(child_id).get_var() == var) {
+                child_id = hierarchy.get_node(child_id).get_child(subtask_value);
+            }
+            nodes.push_back(get_entry(child_id));
+        }
+    }
+    assert(static_cast<int>(nodes.size()) == num_entries);
+    nodes.shrink_to_fit();
 }
 }
@@ -1,31 +1,55 @@
 #ifndef CEGAR_CARTESIAN_HEURISTIC_FUNCTION_H
 #define CEGAR_CARTESIAN_HEURISTIC_FUNCTION_H
 
-#include <memory>
+#include "../task_proxy.h"
+
+#include <cassert>
 #include <vector>
 
-class State;
+class AbstractTask;
 
 namespace cegar {
 class RefinementHierarchy;
 /*
   Store RefinementHierarchy and heuristic values for looking up abstract state
   IDs and corresponding heuristic values efficiently.
+
+  The hierarchy is compiled into a single array of switch nodes in
+  breadth-first order. A node for variable v occupies 1 + |dom(v)|
+  consecutive entries: v itself, followed by one entry per value of v.
+  An entry is either the position of the next node (>= 0) or encodes the
+  heuristic value h of the reached abstract state as -h - 1 (< 0). Chains
+  of helper nodes that split off several values of the same variable are
+  collapsed into a single node.
+
+  The entries are indexed by the values of an ancestor task of the
+  abstraction's subtask (the task of the heuristic), so lookups do not
+  need to convert states to the subtask.
 */
 class CartesianHeuristicFunction {
-    // Avoid const to enable moving.
-    std::unique_ptr<RefinementHierarchy> refinement_hierarchy;
-    std::vector<int> h_values;
+    std::vector<int> nodes;
+    // Entry for the root node, encoded like the entries in nodes.
+    int root_entry;
 
 public:
     CartesianHeuristicFunction(
-        std::unique_ptr<RefinementHierarchy> &&hierarchy,
-        std::vector<int> &&h_values);
+        const RefinementHierarchy &hierarchy,
+        const std::vector<int> &h_values,
+        const AbstractTask &ancestor_task);
 
     CartesianHeuristicFunction(const CartesianHeuristicFunction &) = delete;
     CartesianHeuristicFunction(CartesianHeuristicFunction &&) = default;
 
-    int get_value(const State &state) const;
+    // The state must belong to the ancestor task given in the constructor.
+    int get_value(const State &state) const {
+        const std::vector<int> &values = state.get_values();
+        int entry = root_entry;
+        while (entry >= 0) {
+            assert(nodes[entry] < static_cast<int>(values.size()));
+            entry = nodes[entry + 1 + values[nodes[entry]]];
+        }
+        return -(entry + 1);
+    }
 };
 }
 
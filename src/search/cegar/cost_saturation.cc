@@ -14,9 +14,12 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 using namespace std;
 
@@ -89,7 +92,8 @@ CostSaturation::CostSaturation(
     bool use_general_costs,
     PickSplit pick_split,
     utils::RandomNumberGenerator &rng,
-    bool debug)
+    bool debug,
+    int num_threads)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
@@ -98,6 +102,7 @@ CostSaturation::CostSaturation(
       pick_split(pick_split),
       rng(rng),
       debug(debug),
+      num_threads(num_threads),
       num_abstractions(0),
       num_states(0),
       num_non_looping_transitions(0) {
@@ -131,7 +136,7 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     utils::reserve_extra_memory_padding(memory_padding_in_mb);
     for (const shared_ptr<SubtaskGenerator> &subtask_generator : subtask_generators) {
         SharedTasks subtasks = subtask_generator->get_subtasks(task);
-        build_abstractions(subtasks, timer, should_abort);
+        build_abstractions(task, subtasks, timer, should_abort);
         if (should_abort())
             break;
     }
@@ -173,7 +178,7 @@ void CostSaturation::reduce_remaining_costs(
 }
 
 shared_ptr<AbstractTask> CostSaturation::get_remaining_costs_task(
-    shared_ptr<AbstractTask> &parent) const {
+    const shared_ptr<AbstractTask> &parent) const {
     vector<int> costs = remaining_costs;
     return make_shared<extra_tasks::ModifiedOperatorCostsTask>(
         parent, move(costs));
@@ -187,56 +192,98 @@ bool CostSaturation::state_is_dead_end(const State &state) const {
     return false;
 }
 
+void CostSaturation::add_abstraction(
+    unique_ptr<Abstraction> abstraction, const AbstractTask &task) {
+    ++num_abstractions;
+    num_states += abstraction->get_num_states();
+    num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
+    assert(num_states <= max_states);
+
+    vector<int> init_distances = compute_distances(
+        abstraction->get_transition_system().get_outgoing_transitions(),
+        remaining_costs,
+        {abstraction->get_initial_state().get_id()});
+    vector<int> goal_distances = compute_distances(
+        abstraction->get_transition_system().get_incoming_transitions(),
+        remaining_costs,
+        abstraction->get_goals());
+    vector<int> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        init_distances,
+        goal_distances,
+        use_general_costs);
+
+    heuristic_functions.emplace_back(
+        *abstraction->extract_refinement_hierarchy(),
+        goal_distances,
+        task);
+
+    reduce_remaining_costs(saturated_costs);
+}
+
 void CostSaturation::build_abstractions(
+    const shared_ptr<AbstractTask> &task,
     const vector<shared_ptr<AbstractTask>> &subtasks,
     const utils::CountdownTimer &timer,
     function<bool()> should_abort) {
-    int rem_subtasks = subtasks.size();
-    for (shared_ptr<AbstractTask> subtask : subtasks) {
-        subtask = get_remaining_costs_task(subtask);
+    int num_subtasks = subtasks.size();
+    int rem_subtasks = num_subtasks;
+    utils::ThreadPool thread_pool(max(1, min(num_threads, num_subtasks)));
+    for (int first = 0; first < num_subtasks; first += num_threads) {
+        int batch_size = min(num_threads, num_subtasks - first);
 
         assert(num_states < max_states);
-        CEGAR cegar(
-            subtask,
-            max(1, (max_states - num_states) / rem_subtasks),
-            max(1, (max_non_looping_transitions - num_non_looping_transitions) /
-                rem_subtasks),
-            timer.get_remaining_time() / rem_subtasks,
-            pick_split,
-            rng,
-            debug);
-
-        unique_ptr<Abstraction> abstraction = cegar.extract_abstraction();
-        ++num_abstractions;
-        num_states += abstraction->get_num_states();
-        num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states <= max_states);
-
-        vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state().get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
-            costs,
-            abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
-
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+        int max_states_per_subtask = max(1, (max_states - num_states) / rem_subtasks);
+        int max_transitions_per_subtask = max(
+            1, (max_non_looping_transitions - num_non_looping_transitions) /
+            rem_subtasks);
+        /*
+          CEGAR measures the CPU time of the whole process, which passes
+          batch_size times faster while the subtasks of a batch are
+          refined concurrently.
+        */
+        double max_time_per_subtask =
+            timer.get_remaining_time() / rem_subtasks * batch_size;
 
-        if (should_abort())
-            break;
+        /*
+          Each concurrently refined subtask uses its own random number
+          generator, seeded in order from the shared one.
+        */
+        vector<shared_ptr<AbstractTask>> batch_subtasks;
+        vector<unique_ptr<utils::RandomNumberGenerator>> batch_rngs;
+        for (int i = 0; i < batch_size; ++i) {
+            batch_subtasks.push_back(
+                get_remaining_costs_task(subtasks[first + i]));
+            if (batch_size > 1) {
+                batch_rngs.push_back(
+                    utils::make_unique_ptr<utils::RandomNumberGenerator>(
+                        rng(numeric_limits<int>::max())));
+            }
+        }
 
-        --rem_subtasks;
+        vector<unique_ptr<Abstraction>> abstractions(batch_size);
+        thread_pool.parallel_for(
+            batch_size,
+            [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    CEGAR cegar(
+                        batch_subtasks[i],
+                        max_states_per_subtask,
+                        max_transitions_per_subtask,
+                        max_time_per_subtask,
+                        pick_split,
+                        batch_size > 1 ? *batch_rngs[i] : rng,
+                        debug);
+                    abstractions[i] = cegar.extract_abstraction();
+                }
+            });
+
+        for (unique_ptr<Abstraction> &abstraction : abstractions) {
+            add_abstraction(move(abstraction), *task);
+            if (should_abort())
+                return;
+            --rem_subtasks;
+        }
     }
 }
 
@@ -14,6 +14,7 @@ class RandomNumberGenerator;
 }
 
 namespace cegar {
+class Abstraction;
 class CartesianHeuristicFunction;
 class SubtaskGenerator;
 
@@ -23,6 +24,13 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With more than one thread, the abstractions for the next num_threads
+  subtasks are refined concurrently, all of them under the costs that
+  remain before the first of them. Since refinement only uses the costs
+  for guidance, the abstractions are afterwards combined with saturated
+  cost partitioning in the usual order under the actual remaining costs,
+  which keeps the heuristic admissible.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -33,6 +41,7 @@ class CostSaturation {
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
     const bool debug;
+    const int num_threads;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
@@ -43,9 +52,12 @@ class CostSaturation {
     void reset(const TaskProxy &task_proxy);
     void reduce_remaining_costs(const std::vector<int> &saturated_costs);
     std::shared_ptr<AbstractTask> get_remaining_costs_task(
-        std::shared_ptr<AbstractTask> &parent) const;
+        const std::shared_ptr<AbstractTask> &parent) const;
     bool state_is_dead_end(const State &state) const;
+    void add_abstraction(
+        std::unique_ptr<Abstraction> abstraction, const AbstractTask &task);
     void build_abstractions(
+        const std::shared_ptr<AbstractTask> &task,
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
         std::function<bool()> should_abort);
@@ -60,7 +72,8 @@ public:
         bool use_general_costs,
         PickSplit pick_split,
         utils::RandomNumberGenerator &rng,
-        bool debug);
+        bool debug,
+        int num_threads = 1);
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
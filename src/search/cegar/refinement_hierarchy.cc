@@ -77,6 +77,10 @@ pair<NodeID, NodeID> RefinementHierarchy::split(
     return make_pair(helper_id, right_child_id);
 }
 
+const Node &RefinementHierarchy::get_node(NodeID node_id) const {
+    return nodes[node_id];
+}
+
 int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     TaskProxy subtask_proxy(*task);
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
@@ -26,6 +26,9 @@ class Node;
   helper nodes, see below). Leaf nodes correspond to the current
   (unsplit) states in an abstraction. The use of helper nodes makes
   this structure a directed acyclic graph (instead of a tree).
+
+  Once the abstraction is built, CartesianHeuristicFunction compiles
+  the hierarchy into a compact array for faster lookups.
 */
 class RefinementHierarchy {
     std::shared_ptr<AbstractTask> task;
@@ -48,6 +51,12 @@ public:
         int left_state_id, int right_state_id);
 
     int get_abstract_state_id(const State &state) const;
+
+    const Node &get_node(NodeID node_id) const;
+
+    const std::shared_ptr<AbstractTask> &get_task() const {
+        return task;
+    }
 };
 
 
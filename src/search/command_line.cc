@@ -154,7 +154,7 @@ string usage(const string &progname) {
     return "usage: \n" +
            progname + " [OPTIONS] --search SEARCH < OUTPUT\n\n"
            "* SEARCH (SearchEngine): configuration of the search algorithm\n"
-           "* OUTPUT (filename): translator output\n\n"
+           "* OUTPUT (filename): translator output or binary task\n\n"
            "Options:\n"
            "--help [NAME]\n"
            "    Prints help for all heuristics, open lists, etc. called NAME.\n"
@@ -165,6 +165,10 @@ string usage(const string &progname) {
            "--evaluator EVALUATOR_PREDEFINITION\n"
            "    Predefines an evaluator that can afterwards be referenced\n"
            "    by the name that is specified in the definition.\n"
+           "--write-binary-task FILENAME\n"
+           "    Converts the translator output to a binary task that is\n"
+           "    faster to load, writes it to FILENAME and exits.\n"
+           "    Must be the only option.\n"
            "--internal-plan-file FILENAME\n"
            "    Plan will be output to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
@@ -0,0 +1,106 @@
+#include "concurrent_state_registry.h"
+
+#include "algorithms/int_packer.h"
+#include "utils/logging.h"
+#include "utils/memory.h"
+
+#include <cassert>
+#include <limits>
+
+using namespace std;
+
+static int get_num_shard_bits(int num_shards) {
+    assert(num_shards >= 1);
+    int num_bits = 0;
+    while ((1 << num_bits) < num_shards) {
+        ++num_bits;
+    }
+    return num_bits;
+}
+
+
+ConcurrentStateRegistry::Shard::Shard(int bins_per_state)
+    : state_data_pool(bins_per_state),
+      registered_states(
+          StateRegistry::StateIDSemanticHash(state_data_pool, bins_per_state),
+          StateRegistry::StateIDSemanticEqual(state_data_pool, bins_per_state)) {
+}
+
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const int_packer::IntPacker &state_packer, int num_shards)
+    : state_packer(state_packer),
+      bins_per_state(state_packer.get_num_bins()),
+      num_shard_bits(get_num_shard_bits(num_shards)),
+      num_states(0) {
+    for (int i = 0; i < (1 << num_shard_bits); ++i) {
+        shards.push_back(utils::make_unique_ptr<Shard>(bins_per_state));
+    }
+}
+
+int ConcurrentStateRegistry::get_shard_index(int_hash_set::HashType hash) const {
+    /*
+      IntHashSet uses the lowest bits of the hash to find the bucket, so
+      we use the highest bits to choose the shard.
+    */
+    if (num_shard_bits == 0) {
+        return 0;
+    }
+    return hash >> (32 - num_shard_bits);
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::insert_state(
+    const PackedStateBin *buffer) {
+    int_hash_set::HashType hash =
+        StateRegistry::StateIDSemanticHash::hash_packed_state(
+            buffer, bins_per_state);
+    int shard_index = get_shard_index(hash);
+    Shard &shard = *shards[shard_index];
+
+    lock_guard<mutex> lock(shard.mutex);
+    int local_id = shard.state_data_pool.size();
+    shard.state_data_pool.push_back(buffer);
+    pair<int, bool> result = shard.registered_states.insert(local_id);
+    bool is_new_entry = result.second;
+    if (is_new_entry) {
+        ++num_states;
+    } else {
+        shard.state_data_pool.pop_back();
+    }
+    assert(shard.registered_states.size() ==
+           static_cast<int>(shard.state_data_pool.size()));
+    assert(result.first < (1 << (31 - num_shard_bits)));
+    StateID id((result.first << num_shard_bits) | shard_index);
+    return make_pair(id, is_new_entry);
+}
+
+const PackedStateBin *ConcurrentStateRegistry::lookup_buffer(StateID id) const {
+    int shard_index = id.value & ((1 << num_shard_bits) - 1);
+    int local_id = id.value >> num_shard_bits;
+    Shard &shard = *shards[shard_index];
+    /*
+      The data itself never moves, but the segment table of the pool may
+      be reallocated by concurrent insertions.
+    */
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.state_data_pool[local_id];
+}
+
+int ConcurrentStateRegistry::get_state_value(
+    const PackedStateBin *buffer, int var) const {
+    return state_packer.get(buffer, var);
+}
+
+void ConcurrentStateRegistry::print_statistics() const {
+    int min_shard_size = numeric_limits<int>::max();
+    int max_shard_size = 0;
+    for (const unique_ptr<Shard> &shard : shards) {
+        int shard_size = shard->registered_states.size();
+        min_shard_size = min(min_shard_size, shard_size);
+        max_shard_size = max(max_shard_size, shard_size);
+    }
+    utils::g_log << "Number of registered states: " << size() << endl;
+    utils::g_log << "Number of registry shards: " << shards.size() << endl;
+    utils::g_log << "States per registry shard: " << min_shard_size << " to "
+                 << max_shard_size << endl;
+}
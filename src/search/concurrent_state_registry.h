@@ -0,0 +1,106 @@
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "global_state.h"
+#include "state_id.h"
+#include "state_registry.h"
+
+#include "algorithms/int_hash_set.h"
+#include "algorithms/segmented_vector.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace int_packer {
+class IntPacker;
+}
+
+/*
+  ConcurrentStateRegistry assigns IDs to packed states and stores their
+  data like StateRegistry, but allows any number of threads to register
+  and look up states at the same time.
+
+  The registry is split into shards. The shard of a state is determined
+  by the upper bits of its hash, so every state can only ever end up in
+  one shard. Each shard has its own state data pool and duplicate
+  detection hash set (using the same hash and equality functors as
+  StateRegistry), protected by its own mutex. With enough shards, two
+  threads rarely compete for the same lock.
+
+  A StateID encodes the shard in its lowest bits and the index within
+  the shard in the remaining bits. IDs are therefore unique but not
+  consecutive, so they cannot be used with PerStateInformation. They
+  must not be mixed with IDs from other registries.
+
+  Packed state data never moves once it is registered, so pointers
+  returned by lookup_buffer() remain valid for the lifetime of the
+  registry and can be read without further synchronization.
+*/
+class ConcurrentStateRegistry {
+    using StateIDSet = int_hash_set::IntHashSet<
+        StateRegistry::StateIDSemanticHash,
+        StateRegistry::StateIDSemanticEqual>;
+
+    struct Shard {
+        std::mutex mutex;
+        segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+        // Keys are indices into the state data pool of this shard.
+        StateIDSet registered_states;
+
+        explicit Shard(int bins_per_state);
+    };
+
+    const int_packer::IntPacker &state_packer;
+    const int bins_per_state;
+    const int num_shard_bits;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<int> num_states;
+
+    int get_shard_index(int_hash_set::HashType hash) const;
+public:
+    /*
+      The number of shards is rounded up to the next power of 2. A few
+      shards per thread are usually enough to make lock contention
+      negligible.
+    */
+    ConcurrentStateRegistry(
+        const int_packer::IntPacker &state_packer, int num_shards);
+    ~ConcurrentStateRegistry() = default;
+
+    /*
+      Register the state with the given packed data if this was not done
+      before. Return the ID of the state and whether it was newly
+      registered. The buffer is copied, so the caller keeps ownership.
+      Thread-safe.
+    */
+    std::pair<StateID, bool> insert_state(const PackedStateBin *buffer);
+
+    /*
+      Return the packed data of the state with the given ID, which must
+      belong to this registry. Thread-safe.
+    */
+    const PackedStateBin *lookup_buffer(StateID id) const;
+
+    int get_state_value(const PackedStateBin *buffer, int var) const;
+
+    int get_bins_per_state() const {
+        return bins_per_state;
+    }
+
+    int get_num_shards() const {
+        return shards.size();
+    }
+
+    // Return the number of states registered so far. Thread-safe.
+    int size() const {
+        return num_states.load(std::memory_order_relaxed);
+    }
+
+    // Must not be called while other threads modify the registry.
+    void print_statistics() const;
+};
+
+#endif
@@ -4,7 +4,11 @@
 #include "evaluator.h"
 #include "search_statistics.h"
 
+#include "utils/profiling.h"
+#include "utils/timer.h"
+
 #include <cassert>
+#include <utility>
 
 using namespace std;
 
@@ -34,7 +38,14 @@ EvaluationContext::EvaluationContext(
 const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     EvaluationResult &result = cache[evaluator];
     if (result.is_uninitialized()) {
-        result = evaluator->compute_result(*this);
+        PROFILE_SCOPE_COUNTER(evaluator->get_profiling_counter());
+        if (statistics && statistics->get_measure_evaluator_times()) {
+            utils::Timer timer;
+            result = evaluator->compute_result(*this);
+            statistics->add_evaluator_time(evaluator, timer.stop());
+        } else {
+            result = evaluator->compute_result(*this);
+        }
         if (statistics &&
             evaluator->is_used_for_counting_evaluations() &&
             result.get_count_evaluation()) {
@@ -44,6 +55,44 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::evaluate_batch(
+    Evaluator *evaluator, const vector<EvaluationContext *> &batch) {
+    vector<EvaluationContext *> unevaluated;
+    unevaluated.reserve(batch.size());
+    for (EvaluationContext *eval_context : batch) {
+        if (eval_context->cache[evaluator].is_uninitialized()) {
+            unevaluated.push_back(eval_context);
+        }
+    }
+    if (unevaluated.empty()) {
+        return;
+    }
+
+    vector<EvaluationResult> results;
+    SearchStatistics *statistics = unevaluated.front()->statistics;
+    {
+        PROFILE_SCOPE_COUNTER(evaluator->get_profiling_counter());
+        if (statistics && statistics->get_measure_evaluator_times()) {
+            utils::Timer timer;
+            evaluator->compute_results(unevaluated, results);
+            statistics->add_evaluator_time(evaluator, timer.stop());
+        } else {
+            evaluator->compute_results(unevaluated, results);
+        }
+    }
+    assert(results.size() == unevaluated.size());
+    for (size_t i = 0; i < unevaluated.size(); ++i) {
+        EvaluationContext &eval_context = *unevaluated[i];
+        EvaluationResult &result = eval_context.cache[evaluator];
+        result = move(results[i]);
+        if (eval_context.statistics &&
+            evaluator->is_used_for_counting_evaluations() &&
+            result.get_count_evaluation()) {
+            eval_context.statistics->inc_evaluations();
+        }
+    }
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
@@ -6,6 +6,7 @@
 #include "operator_id.h"
 
 #include <unordered_map>
+#include <vector>
 
 class Evaluator;
 class GlobalState;
@@ -85,6 +86,15 @@ public:
     ~EvaluationContext() = default;
 
     const EvaluationResult &get_result(Evaluator *eval);
+
+    /*
+      Compute the results of the given evaluator for all contexts in the
+      batch that do not have a result for it yet and cache them in the
+      contexts. Subsequent get_result() calls are then simple lookups.
+    */
+    static void evaluate_batch(
+        Evaluator *eval, const std::vector<EvaluationContext *> &batch);
+
     const EvaluatorCache &get_cache() const;
     const GlobalState &get_state() const;
     int get_g_value() const;
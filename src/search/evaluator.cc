@@ -4,6 +4,7 @@
 #include "plugin.h"
 
 #include "utils/logging.h"
+#include "utils/profiling.h"
 #include "utils/system.h"
 
 #include <cassert>
@@ -18,13 +19,24 @@ Evaluator::Evaluator(const string &description,
     : description(description),
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
-      use_for_counting_evaluations(use_for_counting_evaluations) {
+      use_for_counting_evaluations(use_for_counting_evaluations),
+      profiling_counter(utils::register_profiling_counter(description)) {
 }
 
 bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    results.clear();
+    results.reserve(batch.size());
+    for (EvaluationContext *eval_context : batch) {
+        results.push_back(compute_result(*eval_context));
+    }
+}
+
 void Evaluator::report_value_for_initial_state(const EvaluationResult &result) const {
     assert(use_for_reporting_minima);
     utils::g_log << "Initial heuristic value for " << description << ": ";
@@ -4,15 +4,21 @@
 #include "evaluation_result.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class GlobalState;
 
+namespace utils {
+class ProfilingCounter;
+}
+
 class Evaluator {
     const std::string description;
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
     const bool use_for_counting_evaluations;
+    const utils::ProfilingCounter &profiling_counter;
 
 public:
     Evaluator(
@@ -76,10 +82,30 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results should compute the results for a batch of
+      evaluation contexts and store them in results, in the same order
+      as the contexts. Like compute_result, it should not add the
+      results to the evaluation contexts.
+
+      The default implementation calls compute_result for each context.
+      Evaluators that can share work between several states (e.g.,
+      setup costs or memory lookups) can override this method. Search
+      engines should call EvaluationContext::evaluate_batch instead of
+      calling this method directly.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results);
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
     const std::string &get_description() const;
+    // Counter for profiling the computations of this evaluator.
+    const utils::ProfilingCounter &get_profiling_counter() const {
+        return profiling_counter;
+    }
     bool is_used_for_reporting_minima() const;
     bool is_used_for_boosting() const;
     bool is_used_for_counting_evaluations() const;
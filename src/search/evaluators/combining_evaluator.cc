@@ -45,6 +45,16 @@ EvaluationResult CombiningEvaluator::compute_result(
     return result;
 }
 
+void CombiningEvaluator::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    // Evaluate each subevaluator on the whole batch before combining.
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators) {
+        EvaluationContext::evaluate_batch(subevaluator.get(), batch);
+    }
+    Evaluator::compute_results(batch, results);
+}
+
 void CombiningEvaluator::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (auto &subevaluator : subevaluators)
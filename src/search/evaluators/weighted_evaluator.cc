@@ -40,6 +40,13 @@ EvaluationResult WeightedEvaluator::compute_result(
     return result;
 }
 
+void WeightedEvaluator::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    EvaluationContext::evaluate_batch(evaluator.get(), batch);
+    Evaluator::compute_results(batch, results);
+}
+
 void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
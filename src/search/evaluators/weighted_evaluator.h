@@ -4,6 +4,7 @@
 #include "../evaluator.h"
 
 #include <memory>
+#include <vector>
 
 namespace options {
 class Options;
@@ -22,6 +23,9 @@ public:
     virtual bool dead_ends_are_reliable() const override;
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
     virtual void get_path_dependent_evaluators(std::set<Evaluator *> &evals) override;
 };
 }
@@ -20,19 +20,35 @@ GlobalState::GlobalState(
     assert(id != StateID::no_state);
 }
 
+GlobalState::GlobalState(
+    shared_ptr<const vector<PackedStateBin>> &&data,
+    const StateRegistry &registry, StateID id)
+    : buffer(data->data()),
+      owned_buffer(move(data)),
+      registry(&registry),
+      id(id) {
+    assert(id != StateID::no_state);
+}
+
 int GlobalState::operator[](int var) const {
     assert(var >= 0);
     assert(var < registry->get_num_variables());
     return registry->get_state_value(buffer, var);
 }
 
+TaskProxy GlobalState::get_task() const {
+    return registry->get_task_proxy();
+}
+
 State GlobalState::unpack() const {
-    int num_variables = registry->get_num_variables();
-    vector<int> values(num_variables);
-    for (int var = 0; var < num_variables; ++var)
-        values[var] = (*this)[var];
-    TaskProxy task_proxy = registry->get_task_proxy();
-    return task_proxy.create_state(move(values));
+    vector<int> values;
+    unpack(values);
+    return get_task().create_state(move(values));
+}
+
+void GlobalState::unpack(vector<int> &values) const {
+    values.resize(registry->get_num_variables());
+    registry->unpack_state(buffer, values.data());
 }
 
 void GlobalState::dump_pddl() const {
@@ -5,8 +5,12 @@
 
 #include "algorithms/int_packer.h"
 
+#include <memory>
+#include <vector>
+
 class State;
 class StateRegistry;
+class TaskProxy;
 
 using PackedStateBin = int_packer::IntPacker::Bin;
 
@@ -22,6 +26,11 @@ class GlobalState {
 
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
+    /*
+      Registries that store states in compressed form hand out states with
+      their own copy of the packed data, which buffer then points to.
+    */
+    std::shared_ptr<const std::vector<PackedStateBin>> owned_buffer;
 
     // registry isn't a reference because we want to support operator=
     const StateRegistry *registry;
@@ -30,10 +39,9 @@ class GlobalState {
     // Only used by the state registry.
     GlobalState(
         const PackedStateBin *buffer, const StateRegistry &registry, StateID id);
-
-    const PackedStateBin *get_packed_buffer() const {
-        return buffer;
-    }
+    GlobalState(
+        std::shared_ptr<const std::vector<PackedStateBin>> &&data,
+        const StateRegistry &registry, StateID id);
 
     const StateRegistry &get_registry() const {
         return *registry;
@@ -41,13 +49,30 @@ class GlobalState {
 public:
     ~GlobalState() = default;
 
+    /*
+      Returns the packed state data. This is only needed by code that
+      creates or stores states outside of a single registry, e.g., to
+      move states between registries. Use the registry's state packer
+      to interpret the data.
+    */
+    const PackedStateBin *get_packed_buffer() const {
+        return buffer;
+    }
+
     StateID get_id() const {
         return id;
     }
 
     int operator[](int var) const;
 
+    TaskProxy get_task() const;
+
     State unpack() const;
+    /*
+      Write the values of all variables to values. Unlike unpack(), this
+      does not allocate memory if values is large enough already.
+    */
+    void unpack(std::vector<int> &values) const;
 
     void dump_pddl() const;
     void dump_fdr() const;
@@ -20,7 +20,9 @@ Heuristic::Heuristic(const Options &opts)
       heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
-      task_proxy(*task) {
+      task_proxy(*task),
+      converted_state(task_proxy.create_state(
+                          vector<int>(task->get_num_variables()))) {
 }
 
 Heuristic::~Heuristic() {
@@ -30,8 +32,9 @@ void Heuristic::set_preferred(const OperatorProxy &op) {
     preferred_operators.insert(op.get_ancestor_operator_id(tasks::g_root_task.get()));
 }
 
-State Heuristic::convert_global_state(const GlobalState &global_state) const {
-    return task_proxy.convert_ancestor_state(global_state.unpack());
+const State &Heuristic::convert_global_state(const GlobalState &global_state) {
+    task_proxy.convert_ancestor_state(global_state, converted_state);
+    return converted_state;
 }
 
 void Heuristic::add_options_to_parser(OptionParser &parser) {
@@ -58,6 +58,8 @@ protected:
     const std::shared_ptr<AbstractTask> task;
     // Use task_proxy to access task information.
     TaskProxy task_proxy;
+    // Result of the last call to convert_global_state().
+    State converted_state;
 
     enum {DEAD_END = -1, NO_VALUE = -2};
 
@@ -71,9 +73,15 @@ protected:
     */
     void set_preferred(const OperatorProxy &op);
 
-    /* TODO: Make private and use State instead of GlobalState once all
-       heuristics use the TaskProxy class. */
-    State convert_global_state(const GlobalState &global_state) const;
+    /*
+      The returned state is stored in the heuristic and overwritten by
+      the next call, which avoids allocating memory for every
+      conversion. Copy the state if it is needed after the next call.
+
+      TODO: Make private and use State instead of GlobalState once all
+      heuristics use the TaskProxy class.
+    */
+    const State &convert_global_state(const GlobalState &global_state);
 
 public:
     explicit Heuristic(const options::Options &opts);
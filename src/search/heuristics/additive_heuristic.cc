@@ -20,6 +20,8 @@ AdditiveHeuristic::AdditiveHeuristic(const Options &opts)
     : RelaxationHeuristic(opts),
       did_write_overflow_warning(false) {
     utils::g_log << "Initializing additive heuristic..." << endl;
+    create_batched_exploration(
+        relaxation_heuristic::CostCombination::ADD, MAX_COST_VALUE);
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -72,7 +74,7 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        if (!incremental && prop->is_goal && --unsolved_goals == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
@@ -87,6 +89,63 @@ void AdditiveHeuristic::relaxed_exploration() {
     }
 }
 
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    int cost = get_operator(op_id)->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    return cost;
+}
+
+void AdditiveHeuristic::incremental_exploration() {
+    /*
+      Costs can only increase for propositions whose best supporter
+      depends on a deleted fact. We invalidate them and reinitialize them
+      from their achievers. Together with the added facts, they form the
+      initial queue of a Dijkstra exploration that propagates all cost
+      changes. The costs of all other propositions are still achievable
+      and are only touched if they decrease.
+    */
+    queue.clear();
+    invalidate_affected_propositions(
+        deleted_propositions, affected_propositions);
+    for (PropID prop_id : added_propositions) {
+        Proposition *prop = get_proposition(prop_id);
+        prop->cost = 0;
+        prop->reached_by = NO_OP;
+        queue.push(0, prop_id);
+    }
+    for (PropID prop_id : affected_propositions) {
+        for (OpID op_id : achievers[prop_id]) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(prop_id, cost, op_id);
+        }
+    }
+
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        assert(prop->cost >= 0 && prop->cost <= distance);
+        if (prop->cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(get_operator(op_id)->effect, cost, op_id);
+        }
+    }
+
+    for (Proposition &prop : propositions)
+        prop.marked = false;
+}
+
 void AdditiveHeuristic::mark_preferred_operators(
     const State &state, PropID goal_id) {
     Proposition *goal = get_proposition(goal_id);
@@ -114,9 +173,18 @@ void AdditiveHeuristic::mark_preferred_operators(
 }
 
 int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (load_batched_exploration_result()) {
+        forget_incremental_base_state();
+        if (batched_costs_were_clamped())
+            write_overflow_warning();
+    } else if (compute_incremental_changes(
+                   state, added_propositions, deleted_propositions)) {
+        incremental_exploration();
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -160,7 +228,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
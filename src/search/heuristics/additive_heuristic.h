@@ -7,6 +7,7 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <vector>
 
 class State;
 
@@ -32,9 +33,17 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    // Scratch space for incremental explorations.
+    std::vector<PropID> added_propositions;
+    std::vector<PropID> deleted_propositions;
+    std::vector<PropID> affected_propositions;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
+    void incremental_exploration();
+    // Return the h^add cost of the operator or -1 if it is not reachable.
+    int compute_operator_cost(OpID op_id);
     void mark_preferred_operators(const State &state, PropID goal_id);
 
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
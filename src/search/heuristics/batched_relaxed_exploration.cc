@@ -0,0 +1,166 @@
+#include "batched_relaxed_exploration.h"
+
+#include "relaxation_heuristic.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace relaxation_heuristic {
+const int BatchedRelaxedExploration::UNREACHED;
+
+BatchedRelaxedExploration::BatchedRelaxedExploration(
+    const vector<UnaryOperator> &unary_operators,
+    const vector<vector<PropID>> &preconditions_by_op,
+    int num_propositions,
+    const vector<PropID> &initial_propositions,
+    CostCombination combination,
+    int max_batch_size,
+    int max_cost)
+    : combination(combination),
+      max_batch_size(max_batch_size),
+      max_cost(max_cost),
+      num_propositions(num_propositions),
+      costs(num_propositions * max_batch_size),
+      supporters(num_propositions * max_batch_size),
+      op_costs(max_batch_size),
+      clamped_costs(false) {
+    assert(max_batch_size >= 1);
+    assert(max_cost < UNREACHED);
+    compute_sweep_order(unary_operators, preconditions_by_op, initial_propositions);
+}
+
+void BatchedRelaxedExploration::compute_sweep_order(
+    const vector<UnaryOperator> &unary_operators,
+    const vector<vector<PropID>> &preconditions_by_op,
+    const vector<PropID> &initial_propositions) {
+    /*
+      Compute the h^max layer of all operators for unit costs in the
+      initial state with a breadth-first exploration. Operators that are
+      unreachable in the initial state come last.
+    */
+    int num_ops = unary_operators.size();
+    vector<vector<OpID>> precondition_of(num_propositions);
+    vector<int> unsatisfied_preconditions(num_ops);
+    for (OpID op_id = 0; op_id < num_ops; ++op_id) {
+        for (PropID prop : preconditions_by_op[op_id])
+            precondition_of[prop].push_back(op_id);
+        unsatisfied_preconditions[op_id] = preconditions_by_op[op_id].size();
+    }
+
+    const int INF = numeric_limits<int>::max();
+    vector<int> prop_layer(num_propositions, INF);
+    vector<int> op_layer(num_ops, INF);
+    deque<PropID> queue;
+    auto reach = [&](PropID prop, int layer) {
+            if (prop_layer[prop] == INF) {
+                prop_layer[prop] = layer;
+                queue.push_back(prop);
+            }
+        };
+    for (PropID prop : initial_propositions)
+        reach(prop, 0);
+    for (OpID op_id = 0; op_id < num_ops; ++op_id) {
+        if (unsatisfied_preconditions[op_id] == 0) {
+            op_layer[op_id] = 0;
+            reach(unary_operators[op_id].effect, 1);
+        }
+    }
+    while (!queue.empty()) {
+        PropID prop = queue.front();
+        queue.pop_front();
+        for (OpID op_id : precondition_of[prop]) {
+            if (--unsatisfied_preconditions[op_id] == 0) {
+                op_layer[op_id] = prop_layer[prop];
+                reach(unary_operators[op_id].effect, prop_layer[prop] + 1);
+            }
+        }
+    }
+
+    op_ids.resize(num_ops);
+    iota(op_ids.begin(), op_ids.end(), 0);
+    stable_sort(op_ids.begin(), op_ids.end(),
+                [&](OpID op1, OpID op2) {
+                    return op_layer[op1] < op_layer[op2];
+                });
+
+    base_costs.reserve(num_ops);
+    effects.reserve(num_ops);
+    precondition_offsets.reserve(num_ops + 1);
+    precondition_offsets.push_back(0);
+    for (OpID op_id : op_ids) {
+        const UnaryOperator &op = unary_operators[op_id];
+        base_costs.push_back(op.base_cost);
+        effects.push_back(op.effect);
+        preconditions.insert(preconditions.end(),
+                             preconditions_by_op[op_id].begin(),
+                             preconditions_by_op[op_id].end());
+        precondition_offsets.push_back(preconditions.size());
+    }
+}
+
+bool BatchedRelaxedExploration::sweep() {
+    const int batch_size = max_batch_size;
+    int *op_cost = op_costs.data();
+    bool changed = false;
+    int num_ops = op_ids.size();
+    for (int i = 0; i < num_ops; ++i) {
+        const int base_cost = base_costs[i];
+        for (int k = 0; k < batch_size; ++k)
+            op_cost[k] = base_cost;
+        const PropID *pre_begin = preconditions.data() + precondition_offsets[i];
+        const PropID *pre_end = preconditions.data() + precondition_offsets[i + 1];
+        if (combination == CostCombination::ADD) {
+            for (const PropID *pre = pre_begin; pre != pre_end; ++pre) {
+                const int *pre_cost = &costs[*pre * batch_size];
+                for (int k = 0; k < batch_size; ++k)
+                    op_cost[k] = min(op_cost[k] + pre_cost[k], UNREACHED);
+            }
+            bool clamped = false;
+            for (int k = 0; k < batch_size; ++k) {
+                bool clamp = op_cost[k] > max_cost && op_cost[k] < UNREACHED;
+                clamped |= clamp;
+                op_cost[k] = clamp ? max_cost : op_cost[k];
+            }
+            clamped_costs |= clamped;
+        } else {
+            for (const PropID *pre = pre_begin; pre != pre_end; ++pre) {
+                const int *pre_cost = &costs[*pre * batch_size];
+                for (int k = 0; k < batch_size; ++k)
+                    op_cost[k] = max(op_cost[k], min(base_cost + pre_cost[k], UNREACHED));
+            }
+        }
+
+        int *effect_cost = &costs[effects[i] * batch_size];
+        OpID *effect_supporter = &supporters[effects[i] * batch_size];
+        const OpID op_id = op_ids[i];
+        bool improved = false;
+        for (int k = 0; k < batch_size; ++k) {
+            bool better = op_cost[k] < effect_cost[k];
+            improved |= better;
+            effect_cost[k] = better ? op_cost[k] : effect_cost[k];
+            effect_supporter[k] = better ? op_id : effect_supporter[k];
+        }
+        changed |= improved;
+    }
+    return changed;
+}
+
+bool BatchedRelaxedExploration::compute_costs(const vector<vector<PropID>> &states) {
+    assert(static_cast<int>(states.size()) <= max_batch_size);
+    fill(costs.begin(), costs.end(), UNREACHED);
+    fill(supporters.begin(), supporters.end(), NO_OP);
+    for (size_t k = 0; k < states.size(); ++k) {
+        for (PropID prop : states[k])
+            costs[prop * max_batch_size + k] = 0;
+    }
+    clamped_costs = false;
+    while (sweep()) {
+    }
+    return clamped_costs;
+}
+}
@@ -0,0 +1,96 @@
+#ifndef HEURISTICS_BATCHED_RELAXED_EXPLORATION_H
+#define HEURISTICS_BATCHED_RELAXED_EXPLORATION_H
+
+#include <vector>
+
+namespace relaxation_heuristic {
+struct UnaryOperator;
+
+using PropID = int;
+using OpID = int;
+
+enum class CostCombination {
+    ADD,
+    MAX
+};
+
+/*
+  Relaxed exploration that computes h^add or h^max costs of all
+  propositions for several states at once.
+
+  Instead of a Dijkstra-style exploration with a priority queue per
+  state, we repeatedly sweep over all unary operators and relax the cost
+  of their effects (a generalized Bellman-Ford algorithm) until no cost
+  changes. The costs are stored in structure-of-arrays layout: the costs
+  of one proposition in all states of the batch are contiguous, so that
+  the inner loops over the states are simple min/add/max loops that the
+  compiler vectorizes. The operators are swept in the order of their
+  h^max layer in the initial state, so that in most states a few sweeps
+  suffice.
+
+  The resulting costs are the same as for the priority-queue
+  exploration. For each proposition, we also store a best supporter,
+  i.e., an operator whose cost equals the cost of the proposition. Ties
+  between best supporters may be broken differently than in the
+  priority-queue exploration.
+*/
+class BatchedRelaxedExploration {
+    CostCombination combination;
+    int max_batch_size;
+    int max_cost;
+    int num_propositions;
+
+    // Unary operators in the order in which they are swept.
+    std::vector<OpID> op_ids;
+    std::vector<int> base_costs;
+    std::vector<PropID> effects;
+    std::vector<int> precondition_offsets;
+    std::vector<PropID> preconditions;
+
+    // costs[prop * max_batch_size + i] is the cost of prop in state i.
+    std::vector<int> costs;
+    std::vector<OpID> supporters;
+    // Cost of the current operator in each state.
+    std::vector<int> op_costs;
+    bool clamped_costs;
+
+    void compute_sweep_order(
+        const std::vector<UnaryOperator> &unary_operators,
+        const std::vector<std::vector<PropID>> &preconditions_by_op,
+        const std::vector<PropID> &initial_propositions);
+    bool sweep();
+public:
+    // Cost of propositions that are not reachable.
+    static const int UNREACHED = 1 << 29;
+
+    BatchedRelaxedExploration(
+        const std::vector<UnaryOperator> &unary_operators,
+        const std::vector<std::vector<PropID>> &preconditions_by_op,
+        int num_propositions,
+        const std::vector<PropID> &initial_propositions,
+        CostCombination combination,
+        int max_batch_size,
+        int max_cost);
+
+    /*
+      Compute the costs for the given states, each of which is given as
+      the list of its propositions. Return true iff an operator cost had
+      to be clamped to max_cost.
+    */
+    bool compute_costs(const std::vector<std::vector<PropID>> &states);
+
+    int get_max_batch_size() const {
+        return max_batch_size;
+    }
+
+    int get_cost(int state_index, PropID prop) const {
+        return costs[prop * max_batch_size + state_index];
+    }
+
+    OpID get_supporter(int state_index, PropID prop) const {
+        return supporters[prop * max_batch_size + state_index];
+    }
+};
+}
+
+#endif
@@ -49,7 +49,7 @@ bool CGHeuristic::dead_ends_are_reliable() const {
 }
 
 int CGHeuristic::compute_heuristic(const GlobalState &global_state) {
-    const State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     setup_domain_transition_graphs();
 
     int heuristic = 0;
@@ -1,12 +1,10 @@
 #ifndef HEURISTICS_HM_HEURISTIC_H
 #define HEURISTICS_HM_HEURISTIC_H
 
+#include "hm_table.h"
+
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
 #include <vector>
 
 namespace options {
@@ -17,55 +15,26 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  The h^m values of all tuples are stored in a flat HMTable that is
+  recomputed from scratch for every state.
 */
 
 class HMHeuristic : public Heuristic {
-    using Tuple = std::vector<FactPair>;
     // parameters
     const int m;
     const bool has_cond_effects;
 
-    const Tuple goals;
-
-    // h^m table
-protected:
-    std::map<Tuple, int> hm_table;
-    bool was_updated;
-
-    // auxiliary methods
-    void init_hm_table(const Tuple &t);
-    void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
-
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
+    const std::vector<FactPair> goals;
 
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
+    HMTable hm_table;
 
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
-
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
-
-    void dump_table() const;
-
-    virtual int compute_heuristic(const GlobalState &global_state);
+protected:
+    virtual int compute_heuristic(const GlobalState &global_state) override;
 
 public:
-    std::vector<Tuple> get_unreachable_tuples(const State &state);
-
     explicit HMHeuristic(const options::Options &opts);
 
-    virtual bool dead_ends_are_reliable() const;
+    virtual bool dead_ends_are_reliable() const override;
 };
 }
 
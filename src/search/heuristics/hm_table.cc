@@ -0,0 +1,277 @@
+#include "hm_table.h"
+
+#include "../utils/collections.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+namespace hm_heuristic {
+const int HMTable::UNREACHABLE;
+
+HMTable::HMTable(const TaskProxy &task_proxy, int m)
+    : m(m),
+      num_facts(0),
+      was_updated(false) {
+    VariablesProxy variables = task_proxy.get_variables();
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+        var_of_fact.insert(var_of_fact.end(), var.get_domain_size(), var.get_id());
+    }
+
+    // Check that the table is not too large before computing binomials.
+    double num_tuples = 0;
+    double num_tuples_of_size = 1;
+    for (int k = 1; k <= m; ++k) {
+        num_tuples_of_size = num_tuples_of_size * (num_facts - k + 1) / k;
+        num_tuples += max(0.0, num_tuples_of_size);
+    }
+    if (num_tuples > numeric_limits<int>::max()) {
+        cerr << "h^" << m << " table is too large: " << num_tuples
+             << " tuples" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    binomials.assign(m + 1, vector<size_t>(num_facts + 1, 0));
+    for (int n = 0; n <= num_facts; ++n)
+        binomials[0][n] = 1;
+    for (int k = 1; k <= m; ++k) {
+        for (int n = 1; n <= num_facts; ++n)
+            binomials[k][n] = binomials[k - 1][n - 1] + binomials[k][n - 1];
+    }
+    rank_offsets.assign(m + 2, 0);
+    for (int k = 1; k <= m; ++k)
+        rank_offsets[k + 1] = rank_offsets[k] + binomials[k][num_facts];
+    table.resize(rank_offsets[m + 1]);
+
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        HMOperator hm_op;
+        for (FactProxy pre : op.get_preconditions())
+            hm_op.preconditions.push_back(get_fact_id(pre.get_pair()));
+        for (EffectProxy eff : op.get_effects())
+            hm_op.effects.push_back(get_fact_id(eff.get_fact().get_pair()));
+        utils::sort_unique(hm_op.preconditions);
+        utils::sort_unique(hm_op.effects);
+        hm_op.cost = op.get_cost();
+        operators.push_back(move(hm_op));
+    }
+
+    fact_changed.resize(num_facts);
+    fact_changed_next.resize(num_facts);
+    current_effect_value.assign(variables.size(), -1);
+    current_pre_value.assign(variables.size(), -1);
+}
+
+size_t HMTable::get_index(const vector<int> &tuple) const {
+    int size = tuple.size();
+    assert(size >= 1 && size <= m);
+    size_t index = rank_offsets[size];
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || tuple[i - 1] < tuple[i]);
+        index += binomials[i + 1][tuple[i]];
+    }
+    return index;
+}
+
+bool HMTable::evaluate_subsets(
+    const vector<int> &facts, int start, int size, size_t partial_rank,
+    int &result) const {
+    /*
+      Enumerate all subsets with at most m facts in lexicographic order
+      and compute their ranks incrementally. Return false as soon as we
+      find an unreachable subset.
+    */
+    int num_facts_in_set = facts.size();
+    for (int i = start; i < num_facts_in_set; ++i) {
+        size_t rank = partial_rank + binomials[size + 1][facts[i]];
+        int value = table[rank_offsets[size + 1] + rank];
+        if (value == UNREACHABLE) {
+            result = UNREACHABLE;
+            return false;
+        }
+        result = max(result, value);
+        if (size + 1 < m && !evaluate_subsets(facts, i + 1, size + 1, rank, result))
+            return false;
+    }
+    return true;
+}
+
+void HMTable::set_subsets_to_zero(
+    const vector<int> &facts, int start, int size, size_t partial_rank) {
+    int num_facts_in_set = facts.size();
+    for (int i = start; i < num_facts_in_set; ++i) {
+        size_t rank = partial_rank + binomials[size + 1][facts[i]];
+        table[rank_offsets[size + 1] + rank] = 0;
+        if (size + 1 < m)
+            set_subsets_to_zero(facts, i + 1, size + 1, rank);
+    }
+}
+
+void HMTable::update(const vector<int> &tuple, int value) {
+    int &entry = table[get_index(tuple)];
+    if (value < entry) {
+        entry = value;
+        was_updated = true;
+        for (int fact : tuple)
+            fact_changed_next[fact] = true;
+    }
+}
+
+void HMTable::compute(const State &state) {
+    fill(table.begin(), table.end(), UNREACHABLE);
+    vector<int> state_facts;
+    state_facts.reserve(state.size());
+    for (FactProxy fact : state)
+        state_facts.push_back(get_fact_id(fact.get_pair()));
+    set_subsets_to_zero(state_facts, 0, 0, 0);
+
+    bool first_round = true;
+    do {
+        was_updated = false;
+        fill(fact_changed_next.begin(), fact_changed_next.end(), false);
+        changed_facts.clear();
+        for (int fact = 0; fact < num_facts; ++fact) {
+            if (first_round || fact_changed[fact])
+                changed_facts.push_back(fact);
+        }
+        for (const HMOperator &op : operators) {
+            bool preconditions_changed = first_round || any_of(
+                op.preconditions.begin(), op.preconditions.end(),
+                [this](int fact) {return fact_changed[fact];});
+            if (preconditions_changed || !changed_facts.empty())
+                apply_operator(op, preconditions_changed);
+        }
+        swap(fact_changed, fact_changed_next);
+        first_round = false;
+    } while (was_updated);
+}
+
+void HMTable::apply_operator(const HMOperator &op, bool preconditions_changed) {
+    int pre_cost = 0;
+    evaluate_subsets(op.preconditions, 0, 0, 0, pre_cost);
+    if (pre_cost == UNREACHABLE)
+        return;
+
+    for (int fact : op.effects)
+        current_effect_value[var_of_fact[fact]] = fact;
+    for (int fact : op.preconditions)
+        current_pre_value[var_of_fact[fact]] = fact;
+
+    assert(partial_effect.empty());
+    apply_partial_effects(op, 0, pre_cost + op.cost, preconditions_changed);
+
+    for (int fact : op.effects)
+        current_effect_value[var_of_fact[fact]] = -1;
+    for (int fact : op.preconditions)
+        current_pre_value[var_of_fact[fact]] = -1;
+}
+
+void HMTable::apply_partial_effects(
+    const HMOperator &op, int pos, int cost, bool preconditions_changed) {
+    /*
+      The operator achieves all subsets of its effects with cost
+      h(pre) + cost(op). This value only changes if the value of a
+      precondition tuple changed.
+    */
+    int num_effects = op.effects.size();
+    for (int i = pos; i < num_effects; ++i) {
+        int fact = op.effects[i];
+        // Facts of the same variable are adjacent because effects are sorted.
+        if (!partial_effect.empty() &&
+            var_of_fact[partial_effect.back()] == var_of_fact[fact])
+            continue;
+        partial_effect.push_back(fact);
+        if (preconditions_changed)
+            update(partial_effect, cost);
+        if (static_cast<int>(partial_effect.size()) < m) {
+            assert(extension.empty());
+            extend_partial_effect(op, 0, false, preconditions_changed);
+            apply_partial_effects(op, i + 1, cost, preconditions_changed);
+        }
+        partial_effect.pop_back();
+    }
+}
+
+void HMTable::extend_partial_effect(
+    const HMOperator &op, int first_fact, bool has_changed_fact,
+    bool preconditions_changed) {
+    /*
+      Extend the partial effect by facts that the operator does not
+      delete. The operator achieves the extended tuple if its
+      preconditions and the additional facts are reachable together.
+      If the precondition values did not change, this value can only
+      change if one of the additional facts is part of a changed tuple,
+      so in the last position we only consider changed facts.
+    */
+    int remaining = m - partial_effect.size() - extension.size();
+    assert(remaining >= 1);
+    bool only_changed = !preconditions_changed && !has_changed_fact &&
+        remaining == 1;
+    int num_candidates = only_changed ? changed_facts.size() : num_facts - first_fact;
+    int candidate_offset = 0;
+    if (only_changed) {
+        candidate_offset = lower_bound(
+            changed_facts.begin(), changed_facts.end(), first_fact) -
+            changed_facts.begin();
+        num_candidates -= candidate_offset;
+    }
+    for (int j = 0; j < num_candidates; ++j) {
+        int fact = only_changed ? changed_facts[candidate_offset + j] :
+            first_fact + j;
+        int var = var_of_fact[fact];
+        if (!extension.empty() && var_of_fact[extension.back()] == var)
+            continue;
+        if ((current_effect_value[var] != -1 && current_effect_value[var] != fact) ||
+            (current_pre_value[var] != -1 && current_pre_value[var] != fact))
+            continue;
+        bool var_in_partial_effect = false;
+        for (int effect : partial_effect) {
+            if (var_of_fact[effect] == var) {
+                var_in_partial_effect = true;
+                break;
+            }
+        }
+        if (var_in_partial_effect)
+            continue;
+
+        extension.push_back(fact);
+        bool changed = has_changed_fact || fact_changed[fact];
+        if (preconditions_changed || changed)
+            apply_extension(op);
+        if (remaining > 1)
+            extend_partial_effect(op, fact + 1, changed, preconditions_changed);
+        extension.pop_back();
+    }
+}
+
+void HMTable::apply_extension(const HMOperator &op) {
+    extended_pre.clear();
+    set_union(op.preconditions.begin(), op.preconditions.end(),
+              extension.begin(), extension.end(),
+              back_inserter(extended_pre));
+    int cost = 0;
+    evaluate_subsets(extended_pre, 0, 0, 0, cost);
+    if (cost == UNREACHABLE)
+        return;
+    extended_tuple.clear();
+    merge(partial_effect.begin(), partial_effect.end(),
+          extension.begin(), extension.end(),
+          back_inserter(extended_tuple));
+    update(extended_tuple, cost + op.cost);
+}
+
+int HMTable::get_value(const vector<FactPair> &facts) const {
+    vector<int> fact_ids;
+    fact_ids.reserve(facts.size());
+    for (const FactPair &fact : facts)
+        fact_ids.push_back(get_fact_id(fact));
+    sort(fact_ids.begin(), fact_ids.end());
+    int value = 0;
+    evaluate_subsets(fact_ids, 0, 0, 0, value);
+    return value;
+}
+}
@@ -0,0 +1,106 @@
+#ifndef HEURISTICS_HM_TABLE_H
+#define HEURISTICS_HM_TABLE_H
+
+#include "../task_proxy.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace hm_heuristic {
+/*
+  Table of the h^m values of all sets of at most m facts ("tuples").
+
+  Facts are numbered consecutively (variable by variable), and each
+  tuple of k facts with IDs f_1 < ... < f_k is stored at the position
+  given by its rank in the combinatorial number system,
+  sum_i binomial(f_i, i), behind all tuples with fewer facts. The table
+  is therefore a flat int array without any hashing or comparisons of
+  tuples. Tuples with two facts of the same variable get an index as
+  well, but they are never accessed.
+
+  The values are computed by a semi-naive fixpoint iteration over the
+  operators: an operator is only reconsidered for tuples that contain a
+  fact whose values changed in the previous round.
+
+  Conditional effects are treated like unconditional effects, and axioms
+  are ignored.
+*/
+class HMTable {
+    struct HMOperator {
+        // Sorted fact IDs.
+        std::vector<int> preconditions;
+        std::vector<int> effects;
+        int cost;
+    };
+
+    const int m;
+    int num_facts;
+    std::vector<int> fact_offsets;
+    std::vector<int> var_of_fact;
+    std::vector<HMOperator> operators;
+
+    // binomials[k][n] is the binomial coefficient "n choose k".
+    std::vector<std::vector<std::size_t>> binomials;
+    // rank_offsets[k] is the index of the first tuple with k facts.
+    std::vector<std::size_t> rank_offsets;
+    std::vector<int> table;
+
+    // Facts contained in a tuple whose value changed in the last round.
+    std::vector<bool> fact_changed;
+    std::vector<bool> fact_changed_next;
+    std::vector<int> changed_facts;
+    bool was_updated;
+
+    // Effect and precondition values of the current operator by variable.
+    std::vector<int> current_effect_value;
+    std::vector<int> current_pre_value;
+
+    // Scratch space to avoid allocations in the inner loops.
+    std::vector<int> partial_effect;
+    std::vector<int> extension;
+    std::vector<int> extended_tuple;
+    std::vector<int> extended_pre;
+
+    std::size_t get_index(const std::vector<int> &tuple) const;
+    int get_fact_id(const FactPair &fact) const {
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    bool evaluate_subsets(
+        const std::vector<int> &facts, int start, int size,
+        std::size_t partial_rank, int &result) const;
+    void set_subsets_to_zero(
+        const std::vector<int> &facts, int start, int size,
+        std::size_t partial_rank);
+
+    void update(const std::vector<int> &tuple, int value);
+    void apply_operator(const HMOperator &op, bool preconditions_changed);
+    void apply_partial_effects(
+        const HMOperator &op, int pos, int cost, bool preconditions_changed);
+    void extend_partial_effect(
+        const HMOperator &op, int first_fact, bool has_changed_fact,
+        bool preconditions_changed);
+    void apply_extension(const HMOperator &op);
+public:
+    static const int UNREACHABLE = std::numeric_limits<int>::max();
+
+    HMTable(const TaskProxy &task_proxy, int m);
+
+    // Compute the h^m values of all tuples for the given state.
+    void compute(const State &state);
+
+    /*
+      Return the h^m value of the given facts, i.e., the maximum of the
+      values of all their subsets with at most m facts. The facts must
+      belong to pairwise different variables.
+    */
+    int get_value(const std::vector<FactPair> &facts) const;
+
+    int get_m() const {
+        return m;
+    }
+};
+}
+
+#endif
@@ -25,7 +25,7 @@ LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
 int LandmarkCutHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
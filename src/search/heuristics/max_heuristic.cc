@@ -28,6 +28,9 @@ namespace max_heuristic {
 HSPMaxHeuristic::HSPMaxHeuristic(const Options &opts)
     : RelaxationHeuristic(opts) {
     utils::g_log << "Initializing HSP max heuristic..." << endl;
+    create_batched_exploration(
+        relaxation_heuristic::CostCombination::MAX,
+        relaxation_heuristic::BatchedRelaxedExploration::UNREACHED - 1);
 }
 
 // heuristic computation
@@ -43,14 +46,14 @@ void HSPMaxHeuristic::setup_exploration_queue() {
         op.cost = op.base_cost; // will be increased by precondition costs
 
         if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
+            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
     }
 }
 
 void HSPMaxHeuristic::setup_exploration_queue_state(const State &state) {
     for (FactProxy fact : state) {
         PropID init_prop = get_prop_id(fact);
-        enqueue_if_necessary(init_prop, 0);
+        enqueue_if_necessary(init_prop, 0, NO_OP);
     }
 }
 
@@ -66,7 +69,7 @@ void HSPMaxHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        if (!incremental && prop->is_goal && --unsolved_goals == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
@@ -76,17 +79,73 @@ void HSPMaxHeuristic::relaxed_exploration() {
             --unary_op->unsatisfied_preconditions;
             assert(unary_op->unsatisfied_preconditions >= 0);
             if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+                enqueue_if_necessary(unary_op->effect, unary_op->cost, op_id);
         }
     }
 }
 
-int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state) {
-    const State state = convert_global_state(global_state);
+int HSPMaxHeuristic::compute_operator_cost(OpID op_id) {
+    const UnaryOperator *unary_op = get_operator(op_id);
+    int cost = unary_op->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        cost = max(cost, unary_op->base_cost + precond_cost);
+    }
+    return cost;
+}
+
+void HSPMaxHeuristic::incremental_exploration() {
+    // See AdditiveHeuristic::incremental_exploration().
+    queue.clear();
+    invalidate_affected_propositions(
+        deleted_propositions, affected_propositions);
+    for (PropID prop_id : added_propositions) {
+        Proposition *prop = get_proposition(prop_id);
+        prop->cost = 0;
+        prop->reached_by = NO_OP;
+        queue.push(0, prop_id);
+    }
+    for (PropID prop_id : affected_propositions) {
+        for (OpID op_id : achievers[prop_id]) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(prop_id, cost, op_id);
+        }
+    }
+
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        assert(prop->cost >= 0 && prop->cost <= distance);
+        if (prop->cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(get_operator(op_id)->effect, cost, op_id);
+        }
+    }
+}
 
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state) {
+    if (load_batched_exploration_result()) {
+        forget_incremental_base_state();
+    } else {
+        const State &state = convert_global_state(global_state);
+        if (compute_incremental_changes(
+                state, added_propositions, deleted_propositions)) {
+            incremental_exploration();
+        } else {
+            setup_exploration_queue();
+            setup_exploration_queue_state(state);
+            relaxed_exploration();
+        }
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -113,7 +172,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "no");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
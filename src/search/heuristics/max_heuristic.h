@@ -6,26 +6,38 @@
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
+#include <vector>
 
 namespace max_heuristic {
 using relaxation_heuristic::PropID;
 using relaxation_heuristic::OpID;
 
+using relaxation_heuristic::NO_OP;
+
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
 
 class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
 
+    // Scratch space for incremental explorations.
+    std::vector<PropID> added_propositions;
+    std::vector<PropID> deleted_propositions;
+    std::vector<PropID> affected_propositions;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
+    void incremental_exploration();
+    // Return the h^max cost of the operator or -1 if it is not reachable.
+    int compute_operator_cost(OpID op_id);
 
-    void enqueue_if_necessary(PropID prop_id, int cost) {
+    void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
         Proposition *prop = get_proposition(prop_id);
         if (prop->cost == -1 || prop->cost > cost) {
             prop->cost = cost;
+            prop->reached_by = op_id;
             queue.push(cost, prop_id);
         }
         assert(prop->cost != -1 && prop->cost <= cost);
@@ -1,8 +1,12 @@
 #include "relaxation_heuristic.h"
 
+#include "../evaluation_context.h"
+#include "../option_parser.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -36,7 +40,12 @@ UnaryOperator::UnaryOperator(
 
 // construction and destruction
 RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      batch_size(opts.get<int>("batch_size", 1)),
+      active_batch_lane(-1),
+      batched_costs_clamped(false),
+      incremental(opts.get<bool>("incremental", false)),
+      max_incremental_changes(opts.get<int>("max_incremental_changes", 0)) {
     // Build propositions.
     propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -88,12 +97,155 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    if (incremental) {
+        achievers.resize(propositions.size());
+        for (OpID op_id = 0; op_id < num_unary_ops; ++op_id)
+            achievers[unary_operators[op_id].effect].push_back(op_id);
+        is_affected.resize(propositions.size(), false);
+    }
+}
+
+void RelaxationHeuristic::create_batched_exploration(
+    CostCombination combination, int max_cost) {
+    if (batch_size == 1)
+        return;
+    vector<vector<PropID>> preconditions_by_op;
+    preconditions_by_op.reserve(unary_operators.size());
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id)
+        preconditions_by_op.push_back(get_preconditions_vector(op_id));
+    vector<PropID> initial_propositions;
+    for (FactProxy fact : task_proxy.get_initial_state())
+        initial_propositions.push_back(get_prop_id(fact));
+    batched_exploration = utils::make_unique_ptr<BatchedRelaxedExploration>(
+        unary_operators, preconditions_by_op, propositions.size(),
+        initial_propositions, combination, batch_size, max_cost);
+}
+
+bool RelaxationHeuristic::load_batched_exploration_result() {
+    if (active_batch_lane == -1)
+        return false;
+    int num_propositions = propositions.size();
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        Proposition &prop = propositions[prop_id];
+        int cost = batched_exploration->get_cost(active_batch_lane, prop_id);
+        prop.cost = (cost == BatchedRelaxedExploration::UNREACHED) ? -1 : cost;
+        prop.reached_by = batched_exploration->get_supporter(
+            active_batch_lane, prop_id);
+        prop.marked = false;
+    }
+    return true;
+}
+
+void RelaxationHeuristic::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    if (!batched_exploration) {
+        Heuristic::compute_results(batch, results);
+        return;
+    }
+    results.clear();
+    results.reserve(batch.size());
+    vector<vector<PropID>> states;
+    for (size_t start = 0; start < batch.size(); start += batch_size) {
+        size_t end = min(batch.size(), start + batch_size);
+        states.resize(end - start);
+        for (size_t i = start; i < end; ++i) {
+            vector<PropID> &state_props = states[i - start];
+            state_props.clear();
+            const State &state = convert_global_state(batch[i]->get_state());
+            for (FactProxy fact : state)
+                state_props.push_back(get_prop_id(fact));
+        }
+        batched_costs_clamped = batched_exploration->compute_costs(states);
+        for (size_t i = start; i < end; ++i) {
+            active_batch_lane = i - start;
+            results.push_back(compute_result(*batch[i]));
+        }
+        active_batch_lane = -1;
+        batched_costs_clamped = false;
+    }
+}
+
+bool RelaxationHeuristic::compute_incremental_changes(
+    const State &state, vector<PropID> &added, vector<PropID> &deleted) {
+    added.clear();
+    deleted.clear();
+    if (!incremental)
+        return false;
+    const vector<int> &values = state.get_values();
+    bool has_base_state = !incremental_base_state.empty();
+    if (has_base_state) {
+        int num_vars = values.size();
+        for (int var = 0; var < num_vars; ++var) {
+            int old_value = incremental_base_state[var];
+            if (values[var] != old_value) {
+                added.push_back(get_prop_id(var, values[var]));
+                deleted.push_back(get_prop_id(var, old_value));
+            }
+        }
+    }
+    incremental_base_state = values;
+    return has_base_state &&
+           static_cast<int>(added.size()) <= max_incremental_changes;
+}
+
+void RelaxationHeuristic::invalidate_affected_propositions(
+    const vector<PropID> &deleted, vector<PropID> &affected) {
+    affected.clear();
+    for (PropID prop_id : deleted) {
+        is_affected[prop_id] = true;
+        affected.push_back(prop_id);
+    }
+    // Collect all propositions whose best supporter has an affected precondition.
+    for (size_t i = 0; i < affected.size(); ++i) {
+        const Proposition &prop = propositions[affected[i]];
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop.precondition_of, prop.num_precondition_occurences)) {
+            PropID effect = unary_operators[op_id].effect;
+            if (!is_affected[effect] && propositions[effect].reached_by == op_id) {
+                is_affected[effect] = true;
+                affected.push_back(effect);
+            }
+        }
+    }
+    for (PropID prop_id : affected) {
+        Proposition &prop = propositions[prop_id];
+        prop.cost = -1;
+        prop.reached_by = NO_OP;
+        is_affected[prop_id] = false;
+    }
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
     return !task_properties::has_axioms(task_proxy);
 }
 
+void RelaxationHeuristic::add_options_to_parser(options::OptionParser &parser) {
+    Heuristic::add_options_to_parser(parser);
+    parser.add_option<int>(
+        "batch_size",
+        "number of states whose relaxed explorations are computed together "
+        "when the search engine evaluates states in batches "
+        "(see option batch_successors of eager search). "
+        "With batch_size=1, each state is explored on its own.",
+        "1",
+        options::Bounds("1", "infinity"));
+    parser.add_option<bool>(
+        "incremental",
+        "keep the proposition costs of the last evaluated state and only "
+        "propagate the changes caused by the facts in which the next state "
+        "differs from it. This pays off if consecutively evaluated states "
+        "are similar, e.g., in lazy search.",
+        "false");
+    parser.add_option<int>(
+        "max_incremental_changes",
+        "in incremental mode, recompute all costs from scratch if more than "
+        "this number of variables differ from the last evaluated state",
+        "8",
+        options::Bounds("0", "infinity"));
+}
+
 PropID RelaxationHeuristic::get_prop_id(int var, int value) const {
     return proposition_offsets[var] + value;
 }
@@ -2,12 +2,14 @@
 #define HEURISTICS_RELAXATION_HEURISTIC_H
 
 #include "array_pool.h"
+#include "batched_relaxed_exploration.h"
 
 #include "../heuristic.h"
 
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <memory>
 #include <vector>
 
 class FactProxy;
@@ -18,9 +20,6 @@ namespace relaxation_heuristic {
 struct Proposition;
 struct UnaryOperator;
 
-using PropID = int;
-using OpID = int;
-
 const OpID NO_OP = -1;
 
 struct Proposition {
@@ -61,6 +60,16 @@ class RelaxationHeuristic : public Heuristic {
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    int batch_size;
+    std::unique_ptr<BatchedRelaxedExploration> batched_exploration;
+    // Index of the state in the batch that is currently evaluated or -1.
+    int active_batch_lane;
+    bool batched_costs_clamped;
+
+    // Values of the state for which propositions holds the costs.
+    std::vector<int> incremental_base_state;
+    std::vector<bool> is_affected;
 protected:
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
@@ -69,6 +78,17 @@ protected:
     array_pool::ArrayPool preconditions_pool;
     array_pool::ArrayPool precondition_of_pool;
 
+    /*
+      In incremental mode, the costs of the last evaluated state are
+      kept and only the changes caused by the facts that differ from the
+      next state are propagated. The explorations must not stop early
+      when all goals are reached in this mode.
+    */
+    bool incremental;
+    int max_incremental_changes;
+    // achievers[prop_id]: unary operators with effect prop_id
+    std::vector<std::vector<OpID>> achievers;
+
     array_pool::ArrayPoolSlice get_preconditions(OpID op_id) const {
         const UnaryOperator &op = unary_operators[op_id];
         return preconditions_pool.get_slice(op.preconditions, op.num_preconditions);
@@ -110,10 +130,59 @@ protected:
     const Proposition *get_proposition(int var, int value) const;
     Proposition *get_proposition(int var, int value);
     Proposition *get_proposition(const FactProxy &fact);
+
+    /*
+      Subclasses that support batched evaluation call this method in
+      their constructor. It has no effect if the batch_size option is 1.
+    */
+    void create_batched_exploration(CostCombination combination, int max_cost);
+
+    /*
+      If the current state is evaluated as part of a batch, copy the
+      proposition costs and best supporters computed for it into
+      propositions and return true. Costs of unreached propositions
+      are set to -1. Return false otherwise.
+    */
+    bool load_batched_exploration_result();
+
+    /*
+      Compute the facts that are added and deleted when going from the
+      previously explored state to the given state and make the given
+      state the new base state. Return false if incremental mode is off,
+      there is no base state or more than max_incremental_changes
+      variables differ. In this case, the caller must recompute all
+      costs with a full exploration.
+    */
+    bool compute_incremental_changes(
+        const State &state, std::vector<PropID> &added,
+        std::vector<PropID> &deleted);
+
+    /*
+      Invalidate the costs of all propositions whose best supporter
+      depends on a deleted fact and collect them in affected. Their
+      costs are set to -1 and must be recomputed by the caller.
+    */
+    void invalidate_affected_propositions(
+        const std::vector<PropID> &deleted, std::vector<PropID> &affected);
+
+    void forget_incremental_base_state() {
+        incremental_base_state.clear();
+    }
+
+    // Return true iff operator costs were clamped for the current batch.
+    bool batched_costs_were_clamped() const {
+        return batched_costs_clamped;
+    }
 public:
     explicit RelaxationHeuristic(const options::Options &options);
 
     virtual bool dead_ends_are_reliable() const override;
+
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
+
+    static void add_options_to_parser(options::OptionParser &parser);
 };
 }
 
@@ -87,6 +87,18 @@ LPSolver::LPSolver(LPSolverType solver_type)
       num_permanent_constraints(0),
       has_temporary_constraints_(false) {
     lp_solver = create_lp_solver(solver_type);
+    /*
+      Most changes between solves only modify bounds, which keeps the
+      previous basis dual feasible. Reoptimizing from it with the dual
+      simplex is usually much faster than solving from scratch. With
+      OsiHintTry, solvers that do not support the hint ignore it instead
+      of throwing an exception.
+    */
+    try {
+        lp_solver->setHintParam(OsiDoDualInResolve, true, OsiHintTry);
+    } catch (CoinError &error) {
+        handle_coin_error(error);
+    }
 }
 
 void LPSolver::clear_temporary_data() {
@@ -246,6 +258,9 @@ void LPSolver::set_objective_coefficient(int index, double coefficient) {
 void LPSolver::set_constraint_lower_bound(int index, double bound) {
     assert(index < get_num_constraints());
     try {
+        if (lp_solver->getRowLower()[index] == bound) {
+            return;
+        }
         lp_solver->setRowLower(index, bound);
     } catch (CoinError &error) {
         handle_coin_error(error);
@@ -256,6 +271,9 @@ void LPSolver::set_constraint_lower_bound(int index, double bound) {
 void LPSolver::set_constraint_upper_bound(int index, double bound) {
     assert(index < get_num_constraints());
     try {
+        if (lp_solver->getRowUpper()[index] == bound) {
+            return;
+        }
         lp_solver->setRowUpper(index, bound);
     } catch (CoinError &error) {
         handle_coin_error(error);
@@ -266,6 +284,9 @@ void LPSolver::set_constraint_upper_bound(int index, double bound) {
 void LPSolver::set_variable_lower_bound(int index, double bound) {
     assert(index < get_num_variables());
     try {
+        if (lp_solver->getColLower()[index] == bound) {
+            return;
+        }
         lp_solver->setColLower(index, bound);
     } catch (CoinError &error) {
         handle_coin_error(error);
@@ -276,6 +297,9 @@ void LPSolver::set_variable_lower_bound(int index, double bound) {
 void LPSolver::set_variable_upper_bound(int index, double bound) {
     assert(index < get_num_variables());
     try {
+        if (lp_solver->getColUpper()[index] == bound) {
+            return;
+        }
         lp_solver->setColUpper(index, bound);
     } catch (CoinError &error) {
         handle_coin_error(error);
@@ -120,6 +120,10 @@ public:
 
     LP_METHOD(void set_objective_coefficients(const std::vector<double> &coefficients))
     LP_METHOD(void set_objective_coefficient(int index, double coefficient))
+    /*
+      Setting a bound to its current value keeps the LP solved. Other
+      bound changes are reoptimized from the current basis in solve().
+    */
     LP_METHOD(void set_constraint_lower_bound(int index, double bound))
     LP_METHOD(void set_constraint_upper_bound(int index, double bound))
     LP_METHOD(void set_variable_lower_bound(int index, double bound))
@@ -5,6 +5,7 @@
 
 #include "../algorithms/priority_queues.h"
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <deque>
@@ -169,7 +170,8 @@ void Distances::compute_goal_distances_general_cost() {
 void Distances::compute_distances(
     bool compute_init_distances,
     bool compute_goal_distances,
-    utils::Verbosity verbosity) {
+    utils::Verbosity verbosity,
+    utils::ThreadPool *thread_pool) {
     assert(compute_init_distances || compute_goal_distances);
     /*
       This method does the following:
@@ -229,25 +231,36 @@ void Distances::compute_distances(
         }
         utils::g_log << " distances using ";
     }
-    if (is_unit_cost()) {
-        if (verbosity >= utils::Verbosity::VERBOSE) {
-            utils::g_log << "unit-cost";
-        }
-        if (compute_init_distances) {
-            compute_init_distances_unit_cost();
-        }
-        if (compute_goal_distances) {
-            compute_goal_distances_unit_cost();
-        }
+    bool unit_cost = is_unit_cost();
+    if (verbosity >= utils::Verbosity::VERBOSE) {
+        utils::g_log << (unit_cost ? "unit-cost" : "general-cost");
+    }
+    auto search_from_init = [this, unit_cost]() {
+            if (unit_cost) {
+                compute_init_distances_unit_cost();
+            } else {
+                compute_init_distances_general_cost();
+            }
+        };
+    auto search_from_goals = [this, unit_cost]() {
+            if (unit_cost) {
+                compute_goal_distances_unit_cost();
+            } else {
+                compute_goal_distances_general_cost();
+            }
+        };
+    if (compute_init_distances && compute_goal_distances &&
+        thread_pool && thread_pool->get_num_threads() > 1) {
+        // Both searches only read the transition system.
+        thread_pool->submit(search_from_init);
+        thread_pool->submit(search_from_goals);
+        thread_pool->wait();
     } else {
-        if (verbosity >= utils::Verbosity::VERBOSE) {
-            utils::g_log << "general-cost";
-        }
         if (compute_init_distances) {
-            compute_init_distances_general_cost();
+            search_from_init();
         }
         if (compute_goal_distances) {
-            compute_goal_distances_general_cost();
+            search_from_goals();
         }
     }
     if (verbosity >= utils::Verbosity::VERBOSE) {
@@ -266,7 +279,8 @@ void Distances::apply_abstraction(
     const StateEquivalenceRelation &state_equivalence_relation,
     bool compute_init_distances,
     bool compute_goal_distances,
-    utils::Verbosity verbosity) {
+    utils::Verbosity verbosity,
+    utils::ThreadPool *thread_pool) {
     if (compute_init_distances) {
         assert(are_init_distances_computed());
         assert(state_equivalence_relation.size() < init_distances.size());
@@ -332,7 +346,8 @@ void Distances::apply_abstraction(
         }
         clear_distances();
         compute_distances(
-            compute_init_distances, compute_goal_distances, verbosity);
+            compute_init_distances, compute_goal_distances, verbosity,
+            thread_pool);
     } else {
         init_distances = move(new_init_distances);
         goal_distances = move(new_goal_distances);
@@ -15,6 +15,7 @@
 */
 
 namespace utils {
+class ThreadPool;
 enum class Verbosity;
 }
 
@@ -49,10 +50,15 @@ public:
         return goal_distances_computed;
     }
 
+    /*
+      If a thread pool with several threads is given, init and goal
+      distances are computed concurrently.
+    */
     void compute_distances(
         bool compute_init_distances,
         bool compute_goal_distances,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        utils::ThreadPool *thread_pool = nullptr);
 
     /*
       Update distances according to the given abstraction. If the abstraction
@@ -67,7 +73,8 @@ public:
         const StateEquivalenceRelation &state_equivalence_relation,
         bool compute_init_distances,
         bool compute_goal_distances,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        utils::ThreadPool *thread_pool = nullptr);
 
     int get_init_distance(int state) const {
         assert(are_init_distances_computed());
@@ -10,6 +10,7 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 
@@ -43,6 +44,7 @@ FactoredTransitionSystem::FactoredTransitionSystem(
     vector<unique_ptr<Distances>> &&distances,
     const bool compute_init_distances,
     const bool compute_goal_distances,
+    int num_threads,
     utils::Verbosity verbosity)
     : labels(move(labels)),
       transition_systems(move(transition_systems)),
@@ -50,12 +52,20 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       distances(move(distances)),
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
-      num_active_entries(this->transition_systems.size()) {
+      num_active_entries(this->transition_systems.size()),
+      thread_pool(utils::make_unique_ptr<utils::ThreadPool>(num_threads)) {
+    if (compute_init_distances || compute_goal_distances) {
+        // The atomic factors are small, so we parallelize over factors.
+        thread_pool->parallel_for(
+            this->transition_systems.size(), [&](int begin, int end) {
+                for (int index = begin; index < end; ++index) {
+                    this->distances[index]->compute_distances(
+                        compute_init_distances, compute_goal_distances,
+                        verbosity);
+                }
+            });
+    }
     for (size_t index = 0; index < this->transition_systems.size(); ++index) {
-        if (compute_init_distances || compute_goal_distances) {
-            this->distances[index]->compute_distances(
-                compute_init_distances, compute_goal_distances, verbosity);
-        }
         assert(is_component_valid(index));
     }
 }
@@ -67,7 +77,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(FactoredTransitionSystem &&ot
       distances(move(other.distances)),
       compute_init_distances(move(other.compute_init_distances)),
       compute_goal_distances(move(other.compute_goal_distances)),
-      num_active_entries(move(other.num_active_entries)) {
+      num_active_entries(move(other.num_active_entries)),
+      thread_pool(move(other.thread_pool)) {
     /*
       This is just a default move constructor. Unfortunately Visual
       Studio does not support "= default" for move construction or
@@ -147,7 +158,8 @@ bool FactoredTransitionSystem::apply_abstraction(
             state_equivalence_relation,
             compute_init_distances,
             compute_goal_distances,
-            verbosity);
+            verbosity,
+            thread_pool.get());
     }
     mas_representations[index]->apply_abstraction_to_lookup_table(
         abstraction_mapping);
@@ -169,7 +181,8 @@ int FactoredTransitionSystem::merge(
             *labels,
             *transition_systems[index1],
             *transition_systems[index2],
-            verbosity));
+            verbosity,
+            thread_pool.get()));
     distances[index1] = nullptr;
     distances[index2] = nullptr;
     transition_systems[index1] = nullptr;
@@ -186,7 +199,8 @@ int FactoredTransitionSystem::merge(
     // Restore the invariant that distances are computed.
     if (compute_init_distances || compute_goal_distances) {
         distances[new_index]->compute_distances(
-            compute_init_distances, compute_goal_distances, verbosity);
+            compute_init_distances, compute_goal_distances, verbosity,
+            thread_pool.get());
     }
     --num_active_entries;
     assert(is_component_valid(new_index));
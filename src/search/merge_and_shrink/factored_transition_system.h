@@ -7,6 +7,7 @@
 #include <vector>
 
 namespace utils {
+class ThreadPool;
 enum class Verbosity;
 }
 
@@ -66,6 +67,12 @@ class FactoredTransitionSystem {
     const bool compute_init_distances;
     const bool compute_goal_distances;
     int num_active_entries;
+    /*
+      Threads used for transforming single factors and for scoring merge
+      candidates. The results of all transformations are independent of
+      the number of threads.
+    */
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 
     /*
       Assert that the factor at the given index is in a consistent state, i.e.
@@ -89,6 +96,7 @@ public:
         std::vector<std::unique_ptr<Distances>> &&distances,
         bool compute_init_distances,
         bool compute_goal_distances,
+        int num_threads,
         utils::Verbosity verbosity);
     FactoredTransitionSystem(FactoredTransitionSystem &&other);
     ~FactoredTransitionSystem();
@@ -187,6 +195,11 @@ public:
         return *labels;
     }
 
+    // Used by shrink strategies and merge selectors
+    utils::ThreadPool &get_thread_pool() const {
+        return *thread_pool;
+    }
+
     // The following methods are used for iterating over the FTS
     FTSConstIterator begin() const {
         return FTSConstIterator(*this, false);
@@ -91,6 +91,7 @@ public:
     FactoredTransitionSystem create(
         bool compute_init_distances,
         bool compute_goal_distances,
+        int num_threads,
         utils::Verbosity verbosity);
 };
 
@@ -430,6 +431,7 @@ vector<unique_ptr<Distances>> FTSFactory::create_distances(
 FactoredTransitionSystem FTSFactory::create(
     const bool compute_init_distances,
     const bool compute_goal_distances,
+    int num_threads,
     utils::Verbosity verbosity) {
     if (verbosity >= utils::Verbosity::NORMAL) {
         utils::g_log << "Building atomic transition systems... " << endl;
@@ -453,6 +455,7 @@ FactoredTransitionSystem FTSFactory::create(
         move(distances),
         compute_init_distances,
         compute_goal_distances,
+        num_threads,
         verbosity);
 }
 
@@ -460,10 +463,12 @@ FactoredTransitionSystem create_factored_transition_system(
     const TaskProxy &task_proxy,
     const bool compute_init_distances,
     const bool compute_goal_distances,
+    int num_threads,
     utils::Verbosity verbosity) {
     return FTSFactory(task_proxy).create(
         compute_init_distances,
         compute_goal_distances,
+        num_threads,
         verbosity);
 }
 }
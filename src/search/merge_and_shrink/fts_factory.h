@@ -24,6 +24,7 @@ extern FactoredTransitionSystem create_factored_transition_system(
     const TaskProxy &task_proxy,
     bool compute_init_distances,
     bool compute_goal_distances,
+    int num_threads,
     utils::Verbosity verbosity);
 }
 
@@ -53,6 +53,7 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(const Options &opts) :
     prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
     verbosity(opts.get<utils::Verbosity>("verbosity")),
     main_loop_max_time(opts.get<double>("main_loop_max_time")),
+    num_threads(opts.get<int>("threads")),
     starting_peak_memory(0) {
     assert(max_states_before_merge > 0);
     assert(max_states >= max_states_before_merge);
@@ -98,6 +99,7 @@ void MergeAndShrinkAlgorithm::dump_options() const {
         utils::g_log << endl;
 
         utils::g_log << "Main loop max time in seconds: " << main_loop_max_time << endl;
+        utils::g_log << "Number of threads: " << num_threads << endl;
         utils::g_log << endl;
     }
 }
@@ -348,6 +350,7 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
             task_proxy,
             compute_init_distances,
             compute_goal_distances,
+            num_threads,
             verbosity);
     if (verbosity >= utils::Verbosity::NORMAL) {
         log_progress(timer, "after computation of atomic factors");
@@ -451,6 +454,14 @@ void add_merge_and_shrink_algorithm_options_to_parser(OptionParser &parser) {
         "transformation is runtime-intense.",
         "infinity",
         Bounds("0.0", "infinity"));
+
+    parser.add_option<int>(
+        "threads",
+        "number of threads for computing products, distances, bisimulations "
+        "and merge scores. The computed factored transition system does not "
+        "depend on this number.",
+        "1",
+        Bounds("1", "infinity"));
 }
 
 void add_transition_system_size_limit_options_to_parser(OptionParser &parser) {
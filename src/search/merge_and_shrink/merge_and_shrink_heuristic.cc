@@ -7,6 +7,8 @@
 #include "transition_system.h"
 #include "types.h"
 
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -26,7 +28,8 @@ using utils::ExitCode;
 namespace merge_and_shrink {
 MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     : Heuristic(opts),
-      verbosity(opts.get<utils::Verbosity>("verbosity")) {
+      verbosity(opts.get<utils::Verbosity>("verbosity")),
+      active_batch_index(-1) {
     utils::g_log << "Initializing merge-and-shrink heuristic..." << endl;
     MergeAndShrinkAlgorithm algorithm(opts);
     FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
@@ -51,7 +54,7 @@ void MergeAndShrinkHeuristic::extract_factor(
     }
     assert(distances->are_goal_distances_computed());
     mas_representation->set_distances(*distances);
-    mas_representations.push_back(move(mas_representation));
+    mas_representations.emplace_back(*mas_representation);
 }
 
 bool MergeAndShrinkHeuristic::extract_unsolvable_factor(FactoredTransitionSystem &fts) {
@@ -114,10 +117,13 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
 }
 
 int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    if (active_batch_index != -1) {
+        return batch_h_values[active_batch_index];
+    }
+    const State &state = convert_global_state(global_state);
     int heuristic = 0;
-    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
-        int cost = mas_representation->get_value(state);
+    for (const CompiledMergeAndShrinkRepresentation &mas_representation : mas_representations) {
+        int cost = mas_representation.get_value(state);
         if (cost == PRUNED_STATE || cost == INF) {
             // If state is unreachable or irrelevant, we encountered a dead end.
             return DEAD_END;
@@ -127,6 +133,42 @@ int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state)
     return heuristic;
 }
 
+void MergeAndShrinkHeuristic::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    int num_states = batch.size();
+    vector<State> states;
+    states.reserve(num_states);
+    for (EvaluationContext *eval_context : batch) {
+        states.push_back(convert_global_state(eval_context->get_state()));
+    }
+
+    batch_h_values.assign(num_states, 0);
+    vector<int> costs;
+    for (const CompiledMergeAndShrinkRepresentation &mas_representation : mas_representations) {
+        mas_representation.get_values(states, costs);
+        for (int i = 0; i < num_states; ++i) {
+            int &heuristic = batch_h_values[i];
+            int cost = costs[i];
+            if (heuristic == DEAD_END) {
+                continue;
+            } else if (cost == PRUNED_STATE || cost == INF) {
+                heuristic = DEAD_END;
+            } else {
+                heuristic = max(heuristic, cost);
+            }
+        }
+    }
+
+    results.clear();
+    results.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        active_batch_index = i;
+        results.push_back(compute_result(*batch[i]));
+    }
+    active_batch_index = -1;
+}
+
 static shared_ptr<Heuristic> _parse(options::OptionParser &parser) {
     parser.document_synopsis(
         "Merge-and-shrink heuristic",
@@ -1,6 +1,8 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 
+#include "merge_and_shrink_representation.h"
+
 #include "../heuristic.h"
 
 #include <memory>
@@ -11,13 +13,20 @@ enum class Verbosity;
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
-class MergeAndShrinkRepresentation;
 
 class MergeAndShrinkHeuristic : public Heuristic {
     const utils::Verbosity verbosity;
 
     // The final merge-and-shrink representations, storing goal distances.
-    std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> mas_representations;
+    std::vector<CompiledMergeAndShrinkRepresentation> mas_representations;
+
+    /*
+      Heuristic values computed by compute_results for a batch of states
+      and the index of the state that is currently being evaluated in
+      the batch (or -1).
+    */
+    std::vector<int> batch_h_values;
+    int active_batch_index;
 
     void extract_factor(FactoredTransitionSystem &fts, int index);
     bool extract_unsolvable_factor(FactoredTransitionSystem &fts);
@@ -27,6 +36,11 @@ protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
 public:
     explicit MergeAndShrinkHeuristic(const options::Options &opts);
+
+    // Evaluate all states of the batch in one representation at a time.
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
 };
 }
 
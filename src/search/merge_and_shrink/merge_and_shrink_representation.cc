@@ -6,10 +6,12 @@
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
+#include "../utils/system.h"
 
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 using namespace std;
@@ -71,6 +73,11 @@ bool MergeAndShrinkRepresentationLeaf::is_total() const {
     return true;
 }
 
+int MergeAndShrinkRepresentationLeaf::compile(
+    CompiledMergeAndShrinkRepresentation &compiled) const {
+    return compiled.add_leaf(var_id, lookup_table);
+}
+
 void MergeAndShrinkRepresentationLeaf::dump() const {
     utils::g_log << "lookup table (leaf): ";
     for (const auto &value : lookup_table) {
@@ -144,6 +151,13 @@ bool MergeAndShrinkRepresentationMerge::is_total() const {
     return left_child->is_total() && right_child->is_total();
 }
 
+int MergeAndShrinkRepresentationMerge::compile(
+    CompiledMergeAndShrinkRepresentation &compiled) const {
+    int left_register = left_child->compile(compiled);
+    int right_register = right_child->compile(compiled);
+    return compiled.add_merge(left_register, right_register, lookup_table);
+}
+
 void MergeAndShrinkRepresentationMerge::dump() const {
     utils::g_log << "lookup table (merge): " << endl;
     for (const auto &row : lookup_table) {
@@ -157,4 +171,86 @@ void MergeAndShrinkRepresentationMerge::dump() const {
     utils::g_log << "right child:" << endl;
     right_child->dump();
 }
+
+
+CompiledMergeAndShrinkRepresentation::CompiledMergeAndShrinkRepresentation(
+    const MergeAndShrinkRepresentation &representation) {
+    representation.compile(*this);
+    /*
+      While compiling, add_merge() refers to the i-th merge node as
+      -(i + 1) because the number of leaves is not known yet.
+    */
+    int num_leaves = leaves.size();
+    for (MergeInstruction &merge : merges) {
+        for (int *reg : {&merge.left_register, &merge.right_register}) {
+            if (*reg < 0) {
+                *reg = num_leaves - *reg - 1;
+            }
+        }
+    }
+    registers.resize(leaves.size() + merges.size());
+    leaves.shrink_to_fit();
+    merges.shrink_to_fit();
+    tables.shrink_to_fit();
+}
+
+int CompiledMergeAndShrinkRepresentation::add_leaf(
+    int var_id, const vector<int> &lookup_table) {
+    leaves.push_back({var_id, static_cast<int>(tables.size())});
+    tables.insert(tables.end(), lookup_table.begin(), lookup_table.end());
+    return leaves.size() - 1;
+}
+
+int CompiledMergeAndShrinkRepresentation::add_merge(
+    int left_register, int right_register,
+    const vector<vector<int>> &lookup_table) {
+    int num_rows = lookup_table.size();
+    int row_size = (num_rows == 0 ? 0 : lookup_table[0].size()) + 1;
+    int table_offset = tables.size();
+    if (static_cast<long long>(num_rows + 1) * row_size >
+        numeric_limits<int>::max() - static_cast<long long>(table_offset)) {
+        cerr << "Compiled merge-and-shrink representation is too large."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    tables.insert(tables.end(), row_size, PRUNED_STATE);
+    for (const vector<int> &row : lookup_table) {
+        assert(static_cast<int>(row.size()) + 1 == row_size);
+        tables.push_back(PRUNED_STATE);
+        tables.insert(tables.end(), row.begin(), row.end());
+    }
+    merges.push_back({left_register, right_register, table_offset, row_size});
+    return -static_cast<int>(merges.size());
+}
+
+void CompiledMergeAndShrinkRepresentation::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    int num_states = states.size();
+    if (num_states == 0) {
+        values.clear();
+        return;
+    }
+    int num_leaves = leaves.size();
+    vector<int> batch_registers(registers.size() * num_states);
+    for (int i = 0; i < num_leaves; ++i) {
+        const LeafInstruction &leaf = leaves[i];
+        const int *table = &tables[leaf.table_offset];
+        int *result = &batch_registers[i * num_states];
+        for (int j = 0; j < num_states; ++j) {
+            result[j] = table[states[j].get_values()[leaf.var_id]];
+        }
+    }
+    int reg = num_leaves;
+    for (const MergeInstruction &merge : merges) {
+        const int *table = &tables[merge.table_offset];
+        const int *left = &batch_registers[merge.left_register * num_states];
+        const int *right = &batch_registers[merge.right_register * num_states];
+        int *result = &batch_registers[reg * num_states];
+        for (int j = 0; j < num_states; ++j) {
+            result[j] = table[(left[j] + 1) * merge.row_size + right[j] + 1];
+        }
+        ++reg;
+    }
+    values.assign(batch_registers.end() - num_states, batch_registers.end());
+}
 }
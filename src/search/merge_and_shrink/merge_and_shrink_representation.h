@@ -1,12 +1,13 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include "../task_proxy.h"
+
 #include <memory>
 #include <vector>
 
-class State;
-
 namespace merge_and_shrink {
+class CompiledMergeAndShrinkRepresentation;
 class Distances;
 class MergeAndShrinkRepresentation {
 protected:
@@ -33,6 +34,11 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump() const = 0;
+    /*
+      Add the instructions for this representation and its children to
+      compiled and return the register that holds the value.
+    */
+    virtual int compile(CompiledMergeAndShrinkRepresentation &compiled) const = 0;
 };
 
 
@@ -50,6 +56,8 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual int compile(
+        CompiledMergeAndShrinkRepresentation &compiled) const override;
 };
 
 
@@ -69,6 +77,79 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual int compile(
+        CompiledMergeAndShrinkRepresentation &compiled) const override;
+};
+
+
+/*
+  Merge-and-shrink representation compiled into a straight-line program
+  that computes the same function without recursion and virtual calls.
+
+  The program evaluates the nodes of the tree bottom-up and stores the
+  value of each node in a register. All leaves come first and look up the
+  value of their variable in their table. The merge nodes follow in
+  post-order, so the children of each merge node are evaluated before it
+  and the root is evaluated last. A merge node for children with m and n
+  values looks up entry (left + 1) * (n + 1) + (right + 1) in a table with
+  (m + 1) * (n + 1) entries, where the first row and column store
+  PRUNED_STATE. This propagates pruned states without branching.
+
+  All tables are stored in a single array.
+*/
+class CompiledMergeAndShrinkRepresentation {
+    struct LeafInstruction {
+        int var_id;
+        int table_offset;
+    };
+
+    struct MergeInstruction {
+        int left_register;
+        int right_register;
+        int table_offset;
+        // Number of entries per row of the table.
+        int row_size;
+    };
+
+    std::vector<LeafInstruction> leaves;
+    std::vector<MergeInstruction> merges;
+    std::vector<int> tables;
+    mutable std::vector<int> registers;
+
+public:
+    explicit CompiledMergeAndShrinkRepresentation(
+        const MergeAndShrinkRepresentation &representation);
+
+    // Used by MergeAndShrinkRepresentation::compile().
+    int add_leaf(int var_id, const std::vector<int> &lookup_table);
+    int add_merge(
+        int left_register, int right_register,
+        const std::vector<std::vector<int>> &lookup_table);
+
+    int get_value(const State &state) const {
+        const std::vector<int> &values = state.get_values();
+        int num_leaves = leaves.size();
+        for (int i = 0; i < num_leaves; ++i) {
+            const LeafInstruction &leaf = leaves[i];
+            registers[i] = tables[leaf.table_offset + values[leaf.var_id]];
+        }
+        int reg = num_leaves;
+        for (const MergeInstruction &merge : merges) {
+            registers[reg++] = tables[
+                merge.table_offset +
+                (registers[merge.left_register] + 1) * merge.row_size +
+                registers[merge.right_register] + 1];
+        }
+        return registers.back();
+    }
+
+    /*
+      Compute the values of all given states. Each instruction is applied
+      to all states before moving on to the next instruction, so that only
+      one table is in use at a time.
+    */
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
 };
 }
 
@@ -21,6 +21,15 @@ public:
         const std::vector<std::pair<int, int>> &merge_candidates) = 0;
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
+    /*
+      Return true if compute_scores can be called concurrently for
+      disjoint parts of the merge candidates. This requires that the
+      score of a candidate does not depend on the other candidates and
+      that computing scores does not modify shared state.
+    */
+    virtual bool supports_concurrent_scoring() const {
+        return false;
+    }
 
     // Overriding methods must set initialized to true.
     virtual void initialize(const TaskProxy &) {
@@ -24,6 +24,10 @@ public:
     virtual bool requires_goal_distances() const override {
         return true;
     }
+
+    virtual bool supports_concurrent_scoring() const override {
+        return true;
+    }
 };
 }
 
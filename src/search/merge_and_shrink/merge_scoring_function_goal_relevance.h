@@ -21,6 +21,10 @@ public:
     virtual bool requires_goal_distances() const override {
         return false;
     }
+
+    virtual bool supports_concurrent_scoring() const override {
+        return true;
+    }
 };
 }
 
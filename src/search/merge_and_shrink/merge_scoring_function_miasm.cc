@@ -69,6 +69,10 @@ vector<double> MergeScoringFunctionMIASM::compute_scores(
     return scores;
 }
 
+bool MergeScoringFunctionMIASM::supports_concurrent_scoring() const {
+    return shrink_strategy->is_thread_safe();
+}
+
 string MergeScoringFunctionMIASM::name() const {
     return "miasm";
 }
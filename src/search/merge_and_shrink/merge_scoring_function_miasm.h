@@ -32,6 +32,8 @@ public:
     virtual bool requires_goal_distances() const override {
         return true;
     }
+
+    virtual bool supports_concurrent_scoring() const override;
 };
 }
 
@@ -32,7 +32,8 @@ unique_ptr<TransitionSystem> copy_and_shrink_ts(
       function shrink_factor in utils.cc
     */
     StateEquivalenceRelation equivalence_relation =
-        shrink_strategy.compute_equivalence_relation(ts, distances, new_size);
+        shrink_strategy.compute_equivalence_relation(
+            ts, distances, new_size, nullptr);
     // TODO: We currently violate this; see issue250
     //assert(equivalence_relation.size() <= target_size);
     int new_num_states = equivalence_relation.size();
@@ -7,6 +7,9 @@
 #include "../options/options.h"
 #include "../options/plugin.h"
 
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -39,6 +42,32 @@ vector<pair<int, int>> MergeSelectorScoreBasedFiltering::get_remaining_candidate
     return result;
 }
 
+vector<double> MergeSelectorScoreBasedFiltering::compute_scores(
+    MergeScoringFunction &scoring_function,
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates) const {
+    utils::ThreadPool &thread_pool = fts.get_thread_pool();
+    if (thread_pool.get_num_threads() == 1 ||
+        !scoring_function.supports_concurrent_scoring()) {
+        return scoring_function.compute_scores(fts, merge_candidates);
+    }
+
+    // Score contiguous chunks of the candidates concurrently.
+    vector<double> scores(merge_candidates.size());
+    thread_pool.parallel_for(
+        merge_candidates.size(), [&](int begin, int end) {
+            vector<pair<int, int>> chunk(
+                merge_candidates.begin() + begin,
+                merge_candidates.begin() + end);
+            vector<double> chunk_scores =
+                scoring_function.compute_scores(fts, chunk);
+            assert(chunk_scores.size() == chunk.size());
+            copy(chunk_scores.begin(), chunk_scores.end(),
+                 scores.begin() + begin);
+        });
+    return scores;
+}
+
 pair<int, int> MergeSelectorScoreBasedFiltering::select_merge(
     const FactoredTransitionSystem &fts,
     const vector<int> &indices_subset) const {
@@ -47,8 +76,8 @@ pair<int, int> MergeSelectorScoreBasedFiltering::select_merge(
 
     for (const shared_ptr<MergeScoringFunction> &scoring_function :
          merge_scoring_functions) {
-        vector<double> scores = scoring_function->compute_scores(
-            fts, merge_candidates);
+        vector<double> scores = compute_scores(
+            *scoring_function, fts, merge_candidates);
         merge_candidates = get_remaining_candidates(merge_candidates, scores);
         if (merge_candidates.size() == 1) {
             break;
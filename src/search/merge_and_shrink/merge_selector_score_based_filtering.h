@@ -19,6 +19,10 @@ class MergeSelectorScoreBasedFiltering : public MergeSelector {
     std::vector<std::pair<int, int>> get_remaining_candidates(
         const std::vector<std::pair<int, int>> &merge_candidates,
         const std::vector<double> &scores) const;
+    std::vector<double> compute_scores(
+        MergeScoringFunction &scoring_function,
+        const FactoredTransitionSystem &fts,
+        const std::vector<std::pair<int, int>> &merge_candidates) const;
 protected:
     virtual std::string name() const override;
     virtual void dump_specific_options() const override;
@@ -12,6 +12,7 @@
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
@@ -42,6 +43,12 @@ using SuccessorSignature = vector<pair<int, int>>;
 const int SENTINEL = numeric_limits<int>::max();
 const int IRRELEVANT = SENTINEL - 1;
 
+/*
+  Canonicalizing and sorting only few signatures is not worth the
+  overhead of distributing them among threads.
+*/
+const int MIN_SIGNATURES_PER_THREAD = 1024;
+
 /*
   The following class encodes all we need to know about a state for
   bisimulation: its h value, which equivalence class ("group") it currently
@@ -94,6 +101,53 @@ struct Signature {
 };
 
 
+/*
+  Sort the signatures by sorting contiguous blocks concurrently and then
+  merging neighboring blocks concurrently until a single block remains.
+  Signature::operator< is a total order, so the result is the same as for
+  sorting sequentially.
+*/
+static void sort_signatures(
+    vector<Signature> &signatures, utils::ThreadPool *thread_pool) {
+    int num_signatures = signatures.size();
+    int num_blocks = 1;
+    if (thread_pool) {
+        num_blocks = max(1, min(thread_pool->get_num_threads(),
+                                num_signatures / MIN_SIGNATURES_PER_THREAD));
+    }
+    if (num_blocks == 1) {
+        ::sort(signatures.begin(), signatures.end());
+        return;
+    }
+
+    vector<vector<Signature>::iterator> block_starts;
+    for (int block = 0; block <= num_blocks; ++block) {
+        block_starts.push_back(
+            signatures.begin() +
+            static_cast<long long>(num_signatures) * block / num_blocks);
+    }
+    thread_pool->parallel_for(num_blocks, [&](int begin, int end) {
+            for (int block = begin; block < end; ++block) {
+                ::sort(block_starts[block], block_starts[block + 1]);
+            }
+        });
+    for (int width = 1; width < num_blocks; width *= 2) {
+        int num_merges = (num_blocks + 2 * width - 1) / (2 * width);
+        thread_pool->parallel_for(num_merges, [&](int begin, int end) {
+                for (int merge = begin; merge < end; ++merge) {
+                    int first = merge * 2 * width;
+                    int middle = first + width;
+                    int last = min(first + 2 * width, num_blocks);
+                    if (middle < last) {
+                        inplace_merge(block_starts[first],
+                                      block_starts[middle],
+                                      block_starts[last]);
+                    }
+                }
+            });
+    }
+}
+
 ShrinkBisimulation::ShrinkBisimulation(const Options &opts)
     : greedy(opts.get<bool>("greedy")),
       at_limit(opts.get<AtLimit>("at_limit")) {
@@ -141,7 +195,8 @@ void ShrinkBisimulation::compute_signatures(
     const TransitionSystem &ts,
     const Distances &distances,
     vector<Signature> &signatures,
-    const vector<int> &state_to_group) const {
+    const vector<int> &state_to_group,
+    utils::ThreadPool *thread_pool) const {
     assert(signatures.empty());
 
     // Step 1: Compute bare state signatures (without transition information).
@@ -227,20 +282,30 @@ void ShrinkBisimulation::compute_signatures(
           bisimulation round.
      */
 
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
+    auto canonicalize_successor_signatures = [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                SuccessorSignature &succ_sig = signatures[i].succ_signature;
+                ::sort(succ_sig.begin(), succ_sig.end());
+                succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
+                               succ_sig.end());
+            }
+        };
+    if (thread_pool) {
+        thread_pool->parallel_for(
+            signatures.size(), canonicalize_successor_signatures,
+            MIN_SIGNATURES_PER_THREAD);
+    } else {
+        canonicalize_successor_signatures(0, signatures.size());
     }
 
-    ::sort(signatures.begin(), signatures.end());
+    sort_signatures(signatures, thread_pool);
 }
 
 StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     const TransitionSystem &ts,
     const Distances &distances,
-    int target_size) const {
+    int target_size,
+    utils::ThreadPool *thread_pool) const {
     assert(distances.are_goal_distances_computed());
     int num_states = ts.get_size();
 
@@ -260,7 +325,8 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
         stable = true;
 
         signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
+        compute_signatures(
+            ts, distances, signatures, state_to_group, thread_pool);
 
         // Verify size of signatures and presence of sentinels.
         assert(static_cast<int>(signatures.size()) == num_states + 2);
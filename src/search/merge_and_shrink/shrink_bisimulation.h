@@ -7,6 +7,10 @@ namespace options {
 class Options;
 }
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace merge_and_shrink {
 struct Signature;
 
@@ -34,7 +38,8 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const TransitionSystem &ts,
         const Distances &distances,
         std::vector<Signature> &signatures,
-        const std::vector<int> &state_to_group) const;
+        const std::vector<int> &state_to_group,
+        utils::ThreadPool *thread_pool) const;
 protected:
     virtual void dump_strategy_specific_options() const override;
     virtual std::string name() const override;
@@ -44,7 +49,8 @@ public:
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const override;
+        int target_size,
+        utils::ThreadPool *thread_pool) const override;
 
     virtual bool requires_init_distances() const override {
         return false;
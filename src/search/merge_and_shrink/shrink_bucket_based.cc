@@ -94,7 +94,8 @@ StateEquivalenceRelation ShrinkBucketBased::compute_abstraction(
 StateEquivalenceRelation ShrinkBucketBased::compute_equivalence_relation(
     const TransitionSystem &ts,
     const Distances &distances,
-    int target_size) const {
+    int target_size,
+    utils::ThreadPool *) const {
     vector<Bucket> buckets = partition_into_buckets(ts, distances);
     return compute_abstraction(buckets, target_size);
 }
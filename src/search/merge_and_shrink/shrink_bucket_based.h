@@ -13,6 +13,7 @@ class Options;
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace merge_and_shrink {
@@ -55,7 +56,12 @@ public:
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const override;
+        int target_size,
+        utils::ThreadPool *thread_pool) const override;
+    // Not thread-safe because the shared random number generator is used.
+    virtual bool is_thread_safe() const override {
+        return false;
+    }
     static void add_options_to_parser(options::OptionParser &parser);
 };
 }
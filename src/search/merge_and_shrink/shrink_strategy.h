@@ -6,6 +6,10 @@
 #include <string>
 #include <vector>
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace merge_and_shrink {
 class Distances;
 class TransitionSystem;
@@ -31,11 +35,22 @@ public:
       However, it may attempt to e.g. compute an equivalence relation that
       results in shrinking the transition system in an information-preserving
       way.
+
+      Strategies may use the given thread pool (if not nullptr) to
+      parallelize their computation, but the result must not depend on it.
     */
     virtual StateEquivalenceRelation compute_equivalence_relation(
         const TransitionSystem &ts,
         const Distances &distances,
-        int target_size) const = 0;
+        int target_size,
+        utils::ThreadPool *thread_pool) const = 0;
+    /*
+      Return true if compute_equivalence_relation can be called
+      concurrently from several threads.
+    */
+    virtual bool is_thread_safe() const {
+        return true;
+    }
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
@@ -8,6 +8,7 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
@@ -116,7 +117,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     const Labels &labels,
     const TransitionSystem &ts1,
     const TransitionSystem &ts2,
-    utils::Verbosity verbosity) {
+    utils::Verbosity verbosity,
+    utils::ThreadPool *thread_pool) {
     if (verbosity >= utils::Verbosity::VERBOSE) {
         utils::g_log << "Merging " << ts1.get_description() << " and "
                      << ts2.get_description() << endl;
@@ -161,8 +163,13 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
           l is dead in T1 only and l' is dead in T2 only, so they are not
           locally equivalent in either of the components).
     */
-    int multiplier = ts2_size;
-    vector<int> dead_labels;
+    struct ProductGroup {
+        const vector<Transition> *transitions1;
+        const vector<Transition> *transitions2;
+        vector<int> labels;
+        vector<Transition> transitions;
+    };
+    vector<ProductGroup> product_groups;
     for (GroupAndTransitions gat : ts1) {
         const LabelGroup &group1 = gat.label_group;
         const vector<Transition> &transitions1 = gat.transitions;
@@ -177,38 +184,55 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
-        // Now create the new groups together with their transitions.
         for (auto &bucket : buckets) {
             const vector<Transition> &transitions2 =
                 ts2.get_transitions_for_group_id(bucket.first);
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
             if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
+                && transitions1.size() > vector<Transition>().max_size() / transitions2.size())
                 utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
-                }
-            }
+            product_groups.push_back(
+                {&transitions1, &transitions2, move(bucket.second), {}});
+        }
+    }
 
-            // Create a new group if the transitions are not empty
-            vector<int> &new_labels = bucket.second;
-            if (new_transitions.empty()) {
-                dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
-            } else {
+    // Create the new transitions for all buckets.
+    int multiplier = ts2_size;
+    auto compute_product_transitions = [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                ProductGroup &product_group = product_groups[i];
+                const vector<Transition> &transitions1 = *product_group.transitions1;
+                const vector<Transition> &transitions2 = *product_group.transitions2;
+                vector<Transition> &new_transitions = product_group.transitions;
+                new_transitions.reserve(transitions1.size() * transitions2.size());
+                for (const Transition &transition1 : transitions1) {
+                    int src1 = transition1.src;
+                    int target1 = transition1.target;
+                    for (const Transition &transition2 : transitions2) {
+                        int src2 = transition2.src;
+                        int target2 = transition2.target;
+                        int src = src1 * multiplier + src2;
+                        int target = target1 * multiplier + target2;
+                        new_transitions.push_back(Transition(src, target));
+                    }
+                }
                 sort(new_transitions.begin(), new_transitions.end());
-                label_groups.push_back(move(new_labels));
-                transitions_by_group_id.push_back(move(new_transitions));
             }
+        };
+    if (thread_pool) {
+        thread_pool->parallel_for(product_groups.size(), compute_product_transitions);
+    } else {
+        compute_product_transitions(0, product_groups.size());
+    }
+
+    // Create a new group for each bucket with non-empty transitions.
+    vector<int> dead_labels;
+    for (ProductGroup &product_group : product_groups) {
+        vector<int> &new_labels = product_group.labels;
+        if (product_group.transitions.empty()) {
+            dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
+        } else {
+            label_groups.push_back(move(new_labels));
+            transitions_by_group_id.push_back(move(product_group.transitions));
         }
     }
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 namespace utils {
+class ThreadPool;
 enum class Verbosity;
 }
 
@@ -149,12 +150,16 @@ public:
 
       Invariant: the children ts1 and ts2 must be solvable.
       (It is a bug to merge an unsolvable transition system.)
+
+      If a thread pool is given, the transitions of the new label groups
+      are computed in parallel. The result does not depend on this.
     */
     static std::unique_ptr<TransitionSystem> merge(
         const Labels &labels,
         const TransitionSystem &ts1,
         const TransitionSystem &ts2,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        utils::ThreadPool *thread_pool = nullptr);
 
     /*
       Applies the given state equivalence relation to the transition system.
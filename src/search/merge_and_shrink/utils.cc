@@ -86,7 +86,8 @@ bool shrink_factor(
 
         const Distances &distances = fts.get_distances(index);
         StateEquivalenceRelation equivalence_relation =
-            shrink_strategy.compute_equivalence_relation(ts, distances, new_size);
+            shrink_strategy.compute_equivalence_relation(
+                ts, distances, new_size, &fts.get_thread_pool());
         // TODO: We currently violate this; see issue250
         //assert(equivalence_relation.size() <= target_size);
         return fts.apply_abstraction(index, equivalence_relation, verbosity);
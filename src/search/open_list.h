@@ -55,6 +55,14 @@ public:
     // Return true if the open list is empty.
     virtual bool empty() const = 0;
 
+    /*
+      Return the number of entries in the open list, or -1 if the open
+      list does not keep track of it. Only used for reporting.
+    */
+    virtual int get_num_entries() const {
+        return -1;
+    }
+
     /*
       Remove all elements from the open list.
 
@@ -90,6 +98,12 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Add all evaluators that this open list uses directly into the result
+      set. Evaluators that these depend on are not included.
+    */
+    virtual void get_evaluators(std::set<Evaluator *> &evals) = 0;
+
     /*
       Accessor method for only_preferred.
 
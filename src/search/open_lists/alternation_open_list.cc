@@ -7,6 +7,7 @@
 #include "../utils/memory.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <vector>
@@ -31,10 +32,12 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void boost_preferred() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -85,6 +88,19 @@ bool AlternationOpenList<Entry>::empty() const {
     return true;
 }
 
+template<class Entry>
+int AlternationOpenList<Entry>::get_num_entries() const {
+    // Entries are inserted into all sublists but removed from only one.
+    int num_entries = 0;
+    for (const auto &sublist : open_lists) {
+        int sublist_entries = sublist->get_num_entries();
+        if (sublist_entries == -1)
+            return -1;
+        num_entries = max(num_entries, sublist_entries);
+    }
+    return num_entries;
+}
+
 template<class Entry>
 void AlternationOpenList<Entry>::clear() {
     for (const auto &sublist : open_lists)
@@ -105,6 +121,12 @@ void AlternationOpenList<Entry>::get_path_dependent_evaluators(
         sublist->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void AlternationOpenList<Entry>::get_evaluators(set<Evaluator *> &evals) {
+    for (const auto &sublist : open_lists)
+        sublist->get_evaluators(evals);
+}
+
 template<class Entry>
 bool AlternationOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -34,8 +34,10 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -86,6 +88,11 @@ bool BestFirstOpenList<Entry>::empty() const {
     return size == 0;
 }
 
+template<class Entry>
+int BestFirstOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
 template<class Entry>
 void BestFirstOpenList<Entry>::clear() {
     buckets.clear();
@@ -98,6 +105,11 @@ void BestFirstOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void BestFirstOpenList<Entry>::get_evaluators(set<Evaluator *> &evals) {
+    evals.insert(evaluator.get());
+}
+
 template<class Entry>
 bool BestFirstOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
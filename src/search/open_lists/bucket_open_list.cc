@@ -0,0 +1,297 @@
+#include "bucket_open_list.h"
+
+#include "../evaluation_result.h"
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+/*
+  FIFO queue that reuses its memory. Removed entries are only discarded
+  when the bucket becomes empty or when they make up most of the bucket.
+*/
+template<class Entry>
+class FifoBucket {
+    vector<Entry> entries;
+    size_t head;
+
+public:
+    FifoBucket() : head(0) {
+    }
+
+    void push(const Entry &entry) {
+        entries.push_back(entry);
+    }
+
+    Entry pop() {
+        assert(!empty());
+        Entry result = entries[head++];
+        if (head == entries.size()) {
+            clear();
+        } else if (head >= 1024 && 2 * head >= entries.size()) {
+            entries.erase(entries.begin(), entries.begin() + head);
+            head = 0;
+        }
+        return result;
+    }
+
+    bool empty() const {
+        return head == entries.size();
+    }
+
+    void clear() {
+        entries.clear();
+        head = 0;
+    }
+};
+
+/*
+  Array of buckets indexed by a non-negative key, plus one bucket for
+  infinite keys. min_key is a lower bound for the smallest key with a
+  non-empty bucket.
+*/
+template<class Bucket>
+class BucketLevel {
+    vector<Bucket> buckets;
+    Bucket infinite_bucket;
+    int min_key;
+    int size;
+
+public:
+    BucketLevel() : min_key(0), size(0) {
+    }
+
+    Bucket &get_bucket_for_insertion(int key) {
+        if (key < 0) {
+            cerr << "Bucket open lists do not support negative evaluator "
+                 << "values, got " << key << "." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        ++size;
+        if (key == EvaluationResult::INFTY)
+            return infinite_bucket;
+        if (key >= static_cast<int>(buckets.size()))
+            buckets.resize(key + 1);
+        if (key < min_key)
+            min_key = key;
+        return buckets[key];
+    }
+
+    /*
+      Return the non-empty bucket with the smallest key. The caller must
+      remove exactly one entry from it.
+    */
+    Bucket &get_min_bucket_for_removal() {
+        assert(size > 0);
+        --size;
+        int num_buckets = buckets.size();
+        while (min_key < num_buckets && buckets[min_key].empty())
+            ++min_key;
+        if (min_key == num_buckets) {
+            assert(!infinite_bucket.empty());
+            return infinite_bucket;
+        }
+        return buckets[min_key];
+    }
+
+    bool empty() const {
+        return size == 0;
+    }
+
+    void clear() {
+        for (Bucket &bucket : buckets)
+            bucket.clear();
+        infinite_bucket.clear();
+        min_key = 0;
+        size = 0;
+    }
+};
+
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    using Buckets = BucketLevel<BucketLevel<FifoBucket<Entry>>>;
+
+    Buckets buckets;
+    int size;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual int get_num_entries() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      size(0), evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+    assert(evaluators.size() == 1 || evaluators.size() == 2);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int key = eval_context.get_evaluator_value_or_infinity(evaluators[0].get());
+    int tie_breaking_key = 0;
+    if (evaluators.size() == 2) {
+        tie_breaking_key = eval_context.get_evaluator_value_or_infinity(
+            evaluators[1].get());
+    }
+    buckets.get_bucket_for_insertion(key).get_bucket_for_insertion(
+        tie_breaking_key).push(entry);
+    ++size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    assert(size > 0);
+    --size;
+    return buckets.get_min_bucket_for_removal().get_min_bucket_for_removal().pop();
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+int BucketOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    buckets.clear();
+    size = 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_evaluators(set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evals.insert(evaluator.get());
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // This follows the behaviour of TieBreakingOpenList.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Bucket-based open list",
+        "Open list that orders entries by the value of the first evaluator "
+        "and breaks ties by the value of the optional second evaluator, "
+        "then in FIFO order. It behaves like tiebreaking() with the same "
+        "evaluators, but stores entries in arrays of buckets indexed by "
+        "the evaluator values instead of in balanced search trees.");
+    parser.document_note(
+        "Implementation Notes",
+        "Evaluator values must be non-negative. The memory for the bucket "
+        "arrays grows linearly with the largest finite evaluator value, so "
+        "this open list is best suited for evaluators with small values, "
+        "such as f and h values in tasks with small operator costs.");
+    parser.document_note(
+        "A* with bucket-based open list",
+        "\n```\n--evaluator h=blind()\n"
+        "--search eager(bucket([sum([g(), h]), h]),\n"
+        "               reopen_closed=true, f_eval=sum([g(), h]))\n"
+        "```\n", true);
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "evals", "main evaluator and optional tie-breaking evaluator");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+    parser.add_option<bool>(
+        "unsafe_pruning",
+        "allow unsafe pruning when the main evaluator regards a state a dead end",
+        "true");
+    Options opts = parser.parse();
+    if (parser.help_mode())
+        return nullptr;
+    opts.verify_list_non_empty<shared_ptr<Evaluator>>("evals");
+    if (opts.get_list<shared_ptr<Evaluator>>("evals").size() > 2) {
+        parser.error("bucket open list supports at most two evaluators");
+    }
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("bucket", _parse);
+}
@@ -0,0 +1,30 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+/*
+  Open list indexed by one or two non-negative ints, using FIFO
+  tie-breaking.
+
+  Implemented as an array of buckets indexed by the first key, each of
+  which is an array of FIFO buckets indexed by the second key. Like the
+  BucketQueue in algorithms/priority_queues.h, each level remembers the
+  lowest index that can contain entries, so removing the minimum only
+  scans buckets that became empty since the last removal.
+*/
+
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit BucketOpenListFactory(const Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
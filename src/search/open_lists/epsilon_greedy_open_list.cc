@@ -55,7 +55,9 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_evaluators(set<Evaluator *> &evals) override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
 };
 
@@ -124,11 +126,21 @@ void EpsilonGreedyOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::get_evaluators(set<Evaluator *> &evals) {
+    evals.insert(evaluator.get());
+}
+
 template<class Entry>
 bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
 }
 
+template<class Entry>
+int EpsilonGreedyOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
 template<class Entry>
 void EpsilonGreedyOpenList<Entry>::clear() {
     heap.clear();
@@ -51,6 +51,15 @@ public:
     */
     virtual bool update_constraints(const State &state,
                                     lp::LPSolver &lp_solver) = 0;
+
+    /*
+      Called after initialize_constraints. Mark the variables whose values
+      in a state can influence the constraints generated for it (the
+      vector has one entry per variable). The default implementation
+      marks all variables.
+    */
+    virtual void mark_relevant_variables(
+        std::vector<bool> &relevant_variables) const;
 };
 }
 
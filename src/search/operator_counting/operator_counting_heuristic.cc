@@ -5,6 +5,7 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../utils/logging.h"
 #include "../utils/markup.h"
 
 #include <cmath>
@@ -16,7 +17,11 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
     : Heuristic(opts),
       constraint_generators(
           opts.get_list<shared_ptr<ConstraintGenerator>>("constraint_generators")),
-      lp_solver(opts.get<lp::LPSolverType>("lpsolver")) {
+      lp_solver(opts.get<lp::LPSolverType>("lpsolver")),
+      use_cache(false),
+      max_cache_size(opts.get<int>("max_cache_size")),
+      num_cache_hits(0),
+      num_cache_misses(0) {
     vector<lp::LPVariable> variables;
     double infinity = lp_solver.get_infinity();
     for (OperatorProxy op : task_proxy.get_operators()) {
@@ -28,17 +33,68 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(const Options &opts)
         generator->initialize_constraints(task, constraints, infinity);
     }
     lp_solver.load_problem(lp::LPObjectiveSense::MINIMIZE, variables, constraints);
+
+    if (opts.get<bool>("cache_evaluations") && max_cache_size > 0) {
+        int num_variables = task_proxy.get_variables().size();
+        vector<bool> is_relevant(num_variables, false);
+        for (const auto &generator : constraint_generators) {
+            generator->mark_relevant_variables(is_relevant);
+        }
+        for (int var = 0; var < num_variables; ++var) {
+            if (is_relevant[var]) {
+                relevant_variables.push_back(var);
+            }
+        }
+        use_cache = static_cast<int>(relevant_variables.size()) < num_variables;
+        utils::g_log << "Operator counting LP depends on "
+                     << relevant_variables.size() << " of " << num_variables
+                     << " variables" << (use_cache ? ", caching evaluations." : ".")
+                     << endl;
+    }
 }
 
 OperatorCountingHeuristic::~OperatorCountingHeuristic() {
+    print_statistics();
+}
+
+void OperatorCountingHeuristic::print_statistics() const {
+    if (use_cache) {
+        utils::g_log << "Operator counting cache hits: " << num_cache_hits
+                     << ", misses: " << num_cache_misses
+                     << ", entries: " << cache.size() << endl;
+    }
 }
 
 int OperatorCountingHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
 int OperatorCountingHeuristic::compute_heuristic(const State &state) {
+    if (!use_cache) {
+        return solve_lp(state);
+    }
+    const vector<int> &values = state.get_values();
+    vector<int> key;
+    key.reserve(relevant_variables.size());
+    for (int var : relevant_variables) {
+        key.push_back(values[var]);
+    }
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        ++num_cache_hits;
+        return it->second;
+    }
+    ++num_cache_misses;
+    int result = solve_lp(state);
+    if (static_cast<int>(cache.size()) >= max_cache_size) {
+        cache.clear();
+    }
+    cache.emplace(move(key), result);
+    return result;
+}
+
+int OperatorCountingHeuristic::solve_lp(const State &state) {
     assert(!lp_solver.has_temporary_constraints());
     for (const auto &generator : constraint_generators) {
         bool dead_end = generator->update_constraints(state, lp_solver);
@@ -102,6 +158,21 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.add_list_option<shared_ptr<ConstraintGenerator>>(
         "constraint_generators",
         "methods that generate constraints over operator counting variables");
+    parser.add_option<bool>(
+        "cache_evaluations",
+        "cache heuristic values by the values of the variables that the "
+        "constraints depend on. This only has an effect if the constraints do "
+        "not depend on all variables, e.g., for posthoc optimization "
+        "constraints over few patterns. With state equation constraints, "
+        "the values usually depend on most variables and the cache rarely "
+        "hits.",
+        "false");
+    parser.add_option<int>(
+        "max_cache_size",
+        "maximum number of cached heuristic values. The cache is cleared "
+        "when it is full.",
+        "1000000",
+        Bounds("0", "infinity"));
     lp::add_lp_solver_option_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -5,6 +5,9 @@
 
 #include "../lp/lp_solver.h"
 
+#include "../utils/hash.h"
+
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -18,6 +21,21 @@ class ConstraintGenerator;
 class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
+
+    /*
+      If the constraints only depend on some of the variables, we cache
+      the heuristic values by the values of these variables. The cache is
+      cleared whenever it reaches its maximum size.
+    */
+    bool use_cache;
+    int max_cache_size;
+    std::vector<int> relevant_variables;
+    utils::HashMap<std::vector<int>, int> cache;
+    int64_t num_cache_hits;
+    int64_t num_cache_misses;
+
+    int solve_lp(const State &state);
+    void print_statistics() const;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     int compute_heuristic(const State &state);
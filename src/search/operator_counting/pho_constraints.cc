@@ -65,6 +65,15 @@ bool PhOConstraints::update_constraints(const State &state,
     return false;
 }
 
+void PhOConstraints::mark_relevant_variables(
+    vector<bool> &relevant_variables) const {
+    for (const shared_ptr<pdbs::PatternDatabase> &pdb : *pdbs) {
+        for (int var : pdb->get_pattern()) {
+            relevant_variables[var] = true;
+        }
+    }
+}
+
 static shared_ptr<ConstraintGenerator> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Posthoc optimization constraints",
@@ -30,6 +30,8 @@ public:
         double infinity) override;
     virtual bool update_constraints(
         const State &state, lp::LPSolver &lp_solver) override;
+    virtual void mark_relevant_variables(
+        std::vector<bool> &relevant_variables) const override;
 };
 }
 
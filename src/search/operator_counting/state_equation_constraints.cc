@@ -113,6 +113,18 @@ bool StateEquationConstraints::update_constraints(const State &state,
     return false;
 }
 
+void StateEquationConstraints::mark_relevant_variables(
+    vector<bool> &relevant_variables) const {
+    // Only facts with a constraint influence the LP.
+    for (size_t var = 0; var < propositions.size(); ++var) {
+        for (const Proposition &prop : propositions[var]) {
+            if (prop.constraint_index >= 0) {
+                relevant_variables[var] = true;
+            }
+        }
+    }
+}
+
 static shared_ptr<ConstraintGenerator> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "State equation constraints",
@@ -37,6 +37,8 @@ public:
                                         std::vector<lp::LPConstraint> &constraints,
                                         double infinity);
     virtual bool update_constraints(const State &state, lp::LPSolver &lp_solver);
+    virtual void mark_relevant_variables(
+        std::vector<bool> &relevant_variables) const;
 };
 }
 
@@ -40,4 +40,36 @@ int CanonicalPDBs::get_value(const State &state) const {
     }
     return max_h;
 }
+
+void CanonicalPDBs::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    assert(!pattern_cliques->empty());
+    int num_states = states.size();
+    int num_pdbs = pdbs->size();
+    vector<vector<int>> h_values(num_pdbs);
+    for (int pdb_index = 0; pdb_index < num_pdbs; ++pdb_index) {
+        (*pdbs)[pdb_index]->get_values(states, h_values[pdb_index]);
+    }
+
+    values.assign(num_states, 0);
+    for (int i = 0; i < num_states; ++i) {
+        int &max_h = values[i];
+        for (int pdb_index = 0; pdb_index < num_pdbs; ++pdb_index) {
+            if (h_values[pdb_index][i] == numeric_limits<int>::max()) {
+                max_h = numeric_limits<int>::max();
+                break;
+            }
+        }
+        if (max_h == numeric_limits<int>::max()) {
+            continue;
+        }
+        for (const PatternClique &clique : *pattern_cliques) {
+            int clique_h = 0;
+            for (PatternID pdb_index : clique) {
+                clique_h += h_values[pdb_index][i];
+            }
+            max_h = max(max_h, clique_h);
+        }
+    }
+}
 }
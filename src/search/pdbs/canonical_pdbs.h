@@ -4,6 +4,7 @@
 #include "types.h"
 
 #include <memory>
+#include <vector>
 
 class State;
 
@@ -19,6 +20,10 @@ public:
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+
+    // Compute the values of all given states, one PDB at a time.
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
 };
 }
 
@@ -4,6 +4,7 @@
 #include "pattern_generator.h"
 #include "utils.h"
 
+#include "../evaluation_context.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -32,7 +33,8 @@ CanonicalPDBs get_canonical_pdbs_from_options(
       computed before) so that their computation is not taken into account
       for dominance pruning time.
     */
-    shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
+    shared_ptr<PDBCollection> pdbs =
+        pattern_collection_info.get_pdbs(opts.get<int>("threads"));
     shared_ptr<vector<PatternClique>> pattern_cliques =
         pattern_collection_info.get_pattern_cliques();
 
@@ -64,11 +66,15 @@ CanonicalPDBs get_canonical_pdbs_from_options(
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
     : Heuristic(opts),
-      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)) {
+      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)),
+      active_batch_index(-1) {
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    if (active_batch_index != -1) {
+        return batch_h_values[active_batch_index];
+    }
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -81,6 +87,32 @@ int CanonicalPDBsHeuristic::compute_heuristic(const State &state) const {
     }
 }
 
+void CanonicalPDBsHeuristic::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    int num_states = batch.size();
+    vector<State> states;
+    states.reserve(num_states);
+    for (EvaluationContext *eval_context : batch) {
+        states.push_back(convert_global_state(eval_context->get_state()));
+    }
+
+    canonical_pdbs.get_values(states, batch_h_values);
+    for (int &h : batch_h_values) {
+        if (h == numeric_limits<int>::max()) {
+            h = DEAD_END;
+        }
+    }
+
+    results.clear();
+    results.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        active_batch_index = i;
+        results.push_back(compute_result(*batch[i]));
+    }
+    active_batch_index = -1;
+}
+
 void add_canonical_pdbs_options_to_parser(options::OptionParser &parser) {
     parser.add_option<double>(
         "max_time_dominance_pruning",
@@ -115,6 +147,12 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "systematic(1)");
 
     add_canonical_pdbs_options_to_parser(parser);
+    parser.add_option<int>(
+        "threads",
+        "number of threads for computing the PDBs of the pattern collection "
+        "(if the pattern generator did not compute them already)",
+        "1",
+        Bounds("1", "infinity"));
 
     Heuristic::add_options_to_parser(parser);
 
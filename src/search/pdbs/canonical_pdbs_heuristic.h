@@ -14,6 +14,14 @@ namespace pdbs {
 class CanonicalPDBsHeuristic : public Heuristic {
     CanonicalPDBs canonical_pdbs;
 
+    /*
+      Heuristic values computed by compute_results for a batch of states
+      and the index of the state that is currently being evaluated in
+      the batch (or -1).
+    */
+    std::vector<int> batch_h_values;
+    int active_batch_index;
+
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
@@ -25,6 +33,11 @@ protected:
 public:
     explicit CanonicalPDBsHeuristic(const options::Options &opts);
     virtual ~CanonicalPDBsHeuristic() = default;
+
+    // Look up all states of the batch in one PDB at a time.
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
 };
 
 void add_canonical_pdbs_options_to_parser(options::OptionParser &parser);
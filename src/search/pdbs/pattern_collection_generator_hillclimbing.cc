@@ -20,6 +20,7 @@
 #include "../utils/memory.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -118,6 +119,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       num_samples(opts.get<int>("num_samples")),
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
+      num_threads(opts.get<int>("threads")),
       rng(utils::parse_rng_from_options(opts)),
       num_rejected(0),
       hill_climbing_timer(0) {
@@ -131,7 +133,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    vector<Pattern> new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -158,16 +160,28 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    size_t num_old_candidates = candidate_pdbs.size();
+    candidate_pdbs.resize(num_old_candidates + new_patterns.size());
+    thread_pool->parallel_for(
+        new_patterns.size(),
+        [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                candidate_pdbs[num_old_candidates + i] =
+                    make_shared<PatternDatabase>(task_proxy, new_patterns[i]);
+            }
+        });
+
+    int max_pdb_size = 0;
+    for (size_t i = num_old_candidates; i < candidate_pdbs.size(); ++i)
+        max_pdb_size = max(max_pdb_size, candidate_pdbs[i]->get_size());
     return max_pdb_size;
 }
 
@@ -425,7 +439,9 @@ PatternCollectionInformation PatternCollectionGeneratorHillclimbing::generate(
 
     State initial_state = task_proxy.get_initial_state();
     if (!current_pdbs->is_dead_end(initial_state) && max_time > 0) {
+        thread_pool = utils::make_unique_ptr<utils::ThreadPool>(num_threads);
         hill_climbing(task_proxy);
+        thread_pool = nullptr;
     }
 
     PatternCollectionInformation pci = current_pdbs->get_pattern_collection_information();
@@ -467,6 +483,11 @@ void add_hillclimbing_options(OptionParser &parser) {
         "spent for pruning dominated patterns.",
         "infinity",
         Bounds("0.0", "infinity"));
+    parser.add_option<int>(
+        "threads",
+        "number of threads for building the PDBs of candidate patterns",
+        "1",
+        Bounds("1", "infinity"));
     utils::add_rng_options(parser);
 }
 
@@ -617,6 +638,7 @@ static shared_ptr<Heuristic> _parse_ipdb(OptionParser &parser) {
         "patterns", pgh);
     heuristic_opts.set<double>(
         "max_time_dominance_pruning", opts.get<double>("max_time_dominance_pruning"));
+    heuristic_opts.set<int>("threads", opts.get<int>("threads"));
 
     return make_shared<CanonicalPDBsHeuristic>(heuristic_opts);
 }
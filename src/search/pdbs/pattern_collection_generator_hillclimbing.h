@@ -18,6 +18,7 @@ class Options;
 namespace utils {
 class CountdownTimer;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace sampling {
@@ -39,9 +40,12 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     // minimal improvement required for hill climbing to continue search
     const int min_improvement;
     const double max_time;
+    // number of threads for building candidate PDBs
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 
     // for stats only
     int num_rejected;
@@ -53,6 +57,7 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
       size limit, then the PDB is built and added to candidate_pdbs.
+      The PDBs for all new candidate patterns are built in parallel.
 
       The method returns the size of the largest PDB added to candidate_pdbs.
     */
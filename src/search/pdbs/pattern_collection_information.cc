@@ -5,6 +5,7 @@
 #include "validation.h"
 
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -53,16 +54,26 @@ bool PatternCollectionInformation::information_is_valid() const {
     return true;
 }
 
-void PatternCollectionInformation::create_pdbs_if_missing() {
+void PatternCollectionInformation::create_pdbs_if_missing(int num_threads) {
     assert(patterns);
     if (!pdbs) {
         utils::Timer timer;
         utils::g_log << "Computing PDBs for pattern collection..." << endl;
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
+        int num_patterns = patterns->size();
+        pdbs = make_shared<PDBCollection>(num_patterns);
+        if (num_patterns == 1) {
+            (*pdbs)[0] = make_shared<PatternDatabase>(
+                task_proxy, (*patterns)[0], false, vector<int>(), num_threads);
+        } else {
+            utils::ThreadPool thread_pool(num_threads);
+            thread_pool.parallel_for(
+                num_patterns,
+                [this](int begin, int end) {
+                    for (int i = begin; i < end; ++i) {
+                        (*pdbs)[i] = make_shared<PatternDatabase>(
+                            task_proxy, (*patterns)[i]);
+                    }
+                });
         }
         utils::g_log << "Done computing PDBs for pattern collection: " << timer << endl;
     }
@@ -95,8 +106,8 @@ shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const
     return patterns;
 }
 
-shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs() {
-    create_pdbs_if_missing();
+shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs(int num_threads) {
+    create_pdbs_if_missing(num_threads);
     return pdbs;
 }
 
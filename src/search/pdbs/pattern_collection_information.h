@@ -26,7 +26,7 @@ class PatternCollectionInformation {
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
 
-    void create_pdbs_if_missing();
+    void create_pdbs_if_missing(int num_threads);
     void create_pattern_cliques_if_missing();
 
     bool information_is_valid() const;
@@ -45,7 +45,12 @@ public:
     }
 
     std::shared_ptr<PatternCollection> get_patterns() const;
-    std::shared_ptr<PDBCollection> get_pdbs();
+    /*
+      If the PDBs have not been computed yet, compute them using
+      num_threads threads. Several PDBs are built in parallel. A single
+      PDB uses all threads for its regression search.
+    */
+    std::shared_ptr<PDBCollection> get_pdbs(int num_threads = 1);
     std::shared_ptr<std::vector<PatternClique>> get_pattern_cliques();
 };
 }
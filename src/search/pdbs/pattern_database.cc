@@ -7,13 +7,17 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -70,7 +74,8 @@ PatternDatabase::PatternDatabase(
     const TaskProxy &task_proxy,
     const Pattern &pattern,
     bool dump,
-    const vector<int> &operator_costs)
+    const vector<int> &operator_costs,
+    int num_threads)
     : pattern(pattern) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
@@ -93,7 +98,7 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
+    create_pdb(task_proxy, operator_costs, num_threads);
     if (dump)
         utils::g_log << "PDB construction time: " << timer << endl;
 }
@@ -188,7 +193,8 @@ void PatternDatabase::build_abstract_operators(
 }
 
 void PatternDatabase::create_pdb(
-    const TaskProxy &task_proxy, const vector<int> &operator_costs) {
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    int num_threads) {
     VariablesProxy variables = task_proxy.get_variables();
     vector<int> variable_to_index(variables.size(), -1);
     for (size_t i = 0; i < pattern.size(); ++i) {
@@ -226,19 +232,44 @@ void PatternDatabase::create_pdb(
     }
 
     distances.reserve(num_states);
-    // first implicit entry: priority, second entry: index for an abstract state
-    priority_queues::AdaptiveQueue<size_t> pq;
-
-    // initialize queue
+    vector<size_t> goal_states;
     for (size_t state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
-            pq.push(0, state_index);
+            goal_states.push_back(state_index);
             distances.push_back(0);
         } else {
             distances.push_back(numeric_limits<int>::max());
         }
     }
 
+    if (num_threads == 1) {
+        compute_distances_with_dijkstra(operators, match_tree, goal_states);
+    } else {
+        utils::ThreadPool thread_pool(num_threads);
+        bool has_uniform_costs = all_of(
+            operators.begin(), operators.end(),
+            [&operators](const AbstractOperator &op) {
+                return op.get_cost() == operators[0].get_cost();
+            });
+        if (has_uniform_costs) {
+            compute_distances_with_parallel_bfs(
+                operators, match_tree, goal_states, thread_pool);
+        } else {
+            compute_distances_with_delta_stepping(
+                operators, match_tree, goal_states, thread_pool);
+        }
+    }
+}
+
+void PatternDatabase::compute_distances_with_dijkstra(
+    const vector<AbstractOperator> &operators,
+    const MatchTree &match_tree,
+    const vector<size_t> &goal_states) {
+    // first implicit entry: priority, second entry: index for an abstract state
+    priority_queues::AdaptiveQueue<size_t> pq;
+    for (size_t state_index : goal_states)
+        pq.push(0, state_index);
+
     // Dijkstra loop
     while (!pq.empty()) {
         pair<int, size_t> node = pq.pop();
@@ -263,6 +294,147 @@ void PatternDatabase::create_pdb(
     }
 }
 
+void PatternDatabase::compute_distances_with_parallel_bfs(
+    const vector<AbstractOperator> &operators,
+    const MatchTree &match_tree,
+    const vector<size_t> &goal_states,
+    utils::ThreadPool &thread_pool) {
+    /*
+      All operators have the same cost, so the distance of a state is
+      its breadth-first layer times this cost. The threads expand the
+      states of the current layer in parallel. Each state is claimed by
+      exactly one thread with an atomic flag, so only this thread writes
+      its distance.
+    */
+    const int cost = operators.empty() ? 0 : operators[0].get_cost();
+    vector<atomic<bool>> reached(num_states);
+    for (size_t state_index = 0; state_index < num_states; ++state_index)
+        reached[state_index].store(false, memory_order_relaxed);
+    for (size_t state_index : goal_states)
+        reached[state_index].store(true, memory_order_relaxed);
+
+    vector<size_t> layer = goal_states;
+    vector<size_t> next_layer;
+    mutex next_layer_mutex;
+    int layer_distance = 0;
+    while (!layer.empty()) {
+        layer_distance += cost;
+        next_layer.clear();
+        thread_pool.parallel_for(
+            layer.size(),
+            [&](int begin, int end) {
+                vector<size_t> successors;
+                vector<int> applicable_operator_ids;
+                for (int i = begin; i < end; ++i) {
+                    applicable_operator_ids.clear();
+                    match_tree.get_applicable_operator_ids(
+                        layer[i], applicable_operator_ids);
+                    for (int op_id : applicable_operator_ids) {
+                        size_t predecessor = layer[i] + operators[op_id].get_hash_effect();
+                        if (!reached[predecessor].load(memory_order_relaxed) &&
+                            !reached[predecessor].exchange(true)) {
+                            distances[predecessor] = layer_distance;
+                            successors.push_back(predecessor);
+                        }
+                    }
+                }
+                lock_guard<mutex> lock(next_layer_mutex);
+                next_layer.insert(next_layer.end(), successors.begin(), successors.end());
+            },
+            64);
+        swap(layer, next_layer);
+    }
+}
+
+void PatternDatabase::compute_distances_with_delta_stepping(
+    const vector<AbstractOperator> &operators,
+    const MatchTree &match_tree,
+    const vector<size_t> &goal_states,
+    utils::ThreadPool &thread_pool) {
+    /*
+      Delta-stepping: states are kept in buckets of width delta by their
+      tentative distance. The states of the smallest non-empty bucket
+      are expanded in parallel until the bucket stays empty. Since no
+      operator cost is smaller than delta (except for zero-cost
+      operators, which lead into the current bucket), the distances of
+      all states in a bucket are final once it stays empty. Tentative
+      distances are decreased with an atomic compare-and-swap.
+    */
+    int delta = numeric_limits<int>::max();
+    for (const AbstractOperator &op : operators) {
+        if (op.get_cost() > 0)
+            delta = min(delta, op.get_cost());
+    }
+    if (delta == numeric_limits<int>::max())
+        delta = 1;
+
+    vector<atomic<int>> tentative_distances(num_states);
+    for (size_t state_index = 0; state_index < num_states; ++state_index)
+        tentative_distances[state_index].store(
+            distances[state_index], memory_order_relaxed);
+
+    map<int, vector<size_t>> buckets;
+    buckets[0] = goal_states;
+    mutex buckets_mutex;
+    while (!buckets.empty()) {
+        int bucket_id = buckets.begin()->first;
+        vector<size_t> bucket = move(buckets.begin()->second);
+        buckets.erase(buckets.begin());
+        while (!bucket.empty()) {
+            vector<size_t> next_bucket;
+            thread_pool.parallel_for(
+                bucket.size(),
+                [&](int begin, int end) {
+                    vector<size_t> same_bucket;
+                    vector<pair<int, size_t>> later_buckets;
+                    vector<int> applicable_operator_ids;
+                    for (int i = begin; i < end; ++i) {
+                        size_t state_index = bucket[i];
+                        int distance = tentative_distances[state_index].load();
+                        if (distance / delta != bucket_id) {
+                            // The state was moved to an earlier bucket.
+                            continue;
+                        }
+                        applicable_operator_ids.clear();
+                        match_tree.get_applicable_operator_ids(
+                            state_index, applicable_operator_ids);
+                        for (int op_id : applicable_operator_ids) {
+                            const AbstractOperator &op = operators[op_id];
+                            size_t predecessor = state_index + op.get_hash_effect();
+                            int alternative_cost = distance + op.get_cost();
+                            atomic<int> &old_cost = tentative_distances[predecessor];
+                            int current_cost = old_cost.load();
+                            while (alternative_cost < current_cost &&
+                                   !old_cost.compare_exchange_weak(
+                                       current_cost, alternative_cost)) {
+                            }
+                            if (alternative_cost < current_cost) {
+                                int new_bucket_id = alternative_cost / delta;
+                                if (new_bucket_id == bucket_id) {
+                                    same_bucket.push_back(predecessor);
+                                } else {
+                                    later_buckets.emplace_back(
+                                        new_bucket_id, predecessor);
+                                }
+                            }
+                        }
+                    }
+                    lock_guard<mutex> lock(buckets_mutex);
+                    next_bucket.insert(
+                        next_bucket.end(), same_bucket.begin(), same_bucket.end());
+                    for (const pair<int, size_t> &entry : later_buckets)
+                        buckets[entry.first].push_back(entry.second);
+                },
+                64);
+            swap(bucket, next_bucket);
+        }
+    }
+
+    for (size_t state_index = 0; state_index < num_states; ++state_index)
+        distances[state_index] = tentative_distances[state_index].load(
+            memory_order_relaxed);
+}
+
 bool PatternDatabase::is_goal_state(
     const size_t state_index,
     const vector<FactPair> &abstract_goals,
@@ -292,6 +464,20 @@ int PatternDatabase::get_value(const State &state) const {
     return distances[hash_index(state)];
 }
 
+void PatternDatabase::get_values(
+    const vector<State> &states, vector<int> &values) const {
+    int num_states = states.size();
+    vector<size_t> indices;
+    indices.reserve(num_states);
+    for (const State &state : states) {
+        indices.push_back(hash_index(state));
+    }
+    values.resize(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        values[i] = distances[indices[i]];
+    }
+}
+
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
@@ -8,7 +8,13 @@
 #include <utility>
 #include <vector>
 
+namespace utils {
+class ThreadPool;
+}
+
 namespace pdbs {
+class MatchTree;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -115,14 +121,40 @@ class PatternDatabase {
 
     /*
       Computes all abstract operators, builds the match tree (successor
-      generator) and then does a Dijkstra regression search to compute
-      all final h-values (stored in distances). operator_costs can
-      specify individual operator costs for each operator for action
-      cost partitioning. If left empty, default operator costs are used.
+      generator) and then does a regression search to compute all final
+      h-values (stored in distances). operator_costs can specify
+      individual operator costs for each operator for action cost
+      partitioning. If left empty, default operator costs are used.
+
+      With one thread, the regression search is a Dijkstra search. With
+      more threads, it is a level-synchronous breadth-first search if all
+      abstract operators have the same cost and a delta-stepping search
+      otherwise.
     */
     void create_pdb(
         const TaskProxy &task_proxy,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs,
+        int num_threads);
+
+    /*
+      The following methods compute distances from the given abstract
+      goal states. distances must already map goal states to 0 and all
+      other states to numeric_limits<int>::max().
+    */
+    void compute_distances_with_dijkstra(
+        const std::vector<AbstractOperator> &operators,
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states);
+    void compute_distances_with_parallel_bfs(
+        const std::vector<AbstractOperator> &operators,
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states,
+        utils::ThreadPool &thread_pool);
+    void compute_distances_with_delta_stepping(
+        const std::vector<AbstractOperator> &operators,
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states,
+        utils::ThreadPool &thread_pool);
 
     /*
       For a given abstract state (given as index), the according values
@@ -151,16 +183,27 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       num_threads:    Number of threads used for the regression search.
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
         const Pattern &pattern,
         bool dump = false,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        int num_threads = 1);
     ~PatternDatabase() = default;
 
     int get_value(const State &state) const;
 
+    /*
+      Compute the values of all given states. We compute all indices
+      before looking up any of them, so that the table lookups, which
+      often miss the cache for large PDBs, are not interleaved with the
+      index computations.
+    */
+    void get_values(
+        const std::vector<State> &states, std::vector<int> &values) const;
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
@@ -4,6 +4,7 @@
 #include "validation.h"
 
 #include <cassert>
+#include <vector>
 
 using namespace std;
 
@@ -21,9 +22,10 @@ bool PatternInformation::information_is_valid() const {
     return !pdb || pdb->get_pattern() == pattern;
 }
 
-void PatternInformation::create_pdb_if_missing() {
+void PatternInformation::create_pdb_if_missing(int num_threads) {
     if (!pdb) {
-        pdb = make_shared<PatternDatabase>(task_proxy, pattern);
+        pdb = make_shared<PatternDatabase>(
+            task_proxy, pattern, false, vector<int>(), num_threads);
     }
 }
 
@@ -36,8 +38,8 @@ const Pattern &PatternInformation::get_pattern() const {
     return pattern;
 }
 
-shared_ptr<PatternDatabase> PatternInformation::get_pdb() {
-    create_pdb_if_missing();
+shared_ptr<PatternDatabase> PatternInformation::get_pdb(int num_threads) {
+    create_pdb_if_missing(num_threads);
     return pdb;
 }
 }
@@ -24,7 +24,7 @@ class PatternInformation {
     Pattern pattern;
     std::shared_ptr<PatternDatabase> pdb;
 
-    void create_pdb_if_missing();
+    void create_pdb_if_missing(int num_threads);
 
     bool information_is_valid() const;
 public:
@@ -37,7 +37,8 @@ public:
     }
 
     const Pattern &get_pattern() const;
-    std::shared_ptr<PatternDatabase> get_pdb();
+    // If the PDB has not been computed yet, compute it using num_threads threads.
+    std::shared_ptr<PatternDatabase> get_pdb(int num_threads = 1);
 };
 }
 
@@ -3,6 +3,7 @@
 #include "pattern_database.h"
 #include "pattern_generator.h"
 
+#include "../evaluation_context.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -17,16 +18,20 @@ shared_ptr<PatternDatabase> get_pdb_from_options(const shared_ptr<AbstractTask>
     shared_ptr<PatternGenerator> pattern_generator =
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     PatternInformation pattern_info = pattern_generator->generate(task);
-    return pattern_info.get_pdb();
+    return pattern_info.get_pdb(opts.get<int>("threads"));
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
     : Heuristic(opts),
-      pdb(get_pdb_from_options(task, opts)) {
+      pdb(get_pdb_from_options(task, opts)),
+      active_batch_index(-1) {
 }
 
 int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    if (active_batch_index != -1) {
+        return batch_h_values[active_batch_index];
+    }
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -37,6 +42,32 @@ int PDBHeuristic::compute_heuristic(const State &state) const {
     return h;
 }
 
+void PDBHeuristic::compute_results(
+    const vector<EvaluationContext *> &batch,
+    vector<EvaluationResult> &results) {
+    int num_states = batch.size();
+    vector<State> states;
+    states.reserve(num_states);
+    for (EvaluationContext *eval_context : batch) {
+        states.push_back(convert_global_state(eval_context->get_state()));
+    }
+
+    pdb->get_values(states, batch_h_values);
+    for (int &h : batch_h_values) {
+        if (h == numeric_limits<int>::max()) {
+            h = DEAD_END;
+        }
+    }
+
+    results.clear();
+    results.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        active_batch_index = i;
+        results.push_back(compute_result(*batch[i]));
+    }
+    active_batch_index = -1;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Pattern database heuristic", "TODO");
     parser.document_language_support("action costs", "supported");
@@ -51,6 +82,11 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    parser.add_option<int>(
+        "threads",
+        "number of threads for the regression search that computes the PDB",
+        "1",
+        Bounds("1", "infinity"));
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
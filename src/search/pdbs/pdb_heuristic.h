@@ -16,6 +16,14 @@ class PatternDatabase;
 // Implements a heuristic for a single PDB.
 class PDBHeuristic : public Heuristic {
     std::shared_ptr<PatternDatabase> pdb;
+
+    /*
+      Heuristic values computed by compute_results for a batch of states
+      and the index of the state that is currently being evaluated in
+      the batch (or -1).
+    */
+    std::vector<int> batch_h_values;
+    int active_batch_index;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
@@ -35,6 +43,11 @@ public:
     */
     PDBHeuristic(const options::Options &opts);
     virtual ~PDBHeuristic() override = default;
+
+    // Look up all states of the batch in the PDB at once.
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &batch,
+        std::vector<EvaluationResult> &results) override;
 };
 }
 
@@ -34,6 +34,26 @@ public:
     }
 };
 
+template<class T>
+class ConstArrayView {
+    const T *p;
+    int size_;
+public:
+    ConstArrayView(const T *p, int size) : p(p), size_(size) {}
+    ConstArrayView(const ConstArrayView<T> &other) = default;
+
+    ConstArrayView<T> &operator=(const ConstArrayView<T> &other) = default;
+
+    const T &operator[](int index) const {
+        assert(index >= 0 && index < size_);
+        return p[index];
+    }
+
+    int size() const {
+        return size_;
+    }
+};
+
 /*
   PerStateArray is used to associate array-like information with states.
   PerStateArray<Entry> logically behaves somewhat like an unordered map
@@ -116,16 +136,22 @@ public:
         return ArrayView<Element>((*entries)[state_id], default_array.size());
     }
 
-    ArrayView<Element> operator[](const GlobalState &) const {
-        ABORT("PerStateArray::operator[] const not implemented. "
-              "See source code for more information.");
-        /*
-          This method is not implemented because it is currently not used and
-          would require quite a bit of boilerplate, introducing a ConstArrayView
-          class similar to ArrayView. If you need it, it should be easy to
-          implement based on PerStateInformation:operator[] const. This method
-          should return a ConstArrayView<Element>.
-        */
+    ConstArrayView<Element> operator[](const GlobalState &state) const {
+        const StateRegistry *registry = &state.get_registry();
+        const segmented_vector::SegmentedArrayVector<Element> *entries =
+            get_entries(registry);
+        if (!entries) {
+            return ConstArrayView<Element>(
+                default_array.data(), default_array.size());
+        }
+        int state_id = state.get_id().value;
+        assert(utils::in_bounds(state_id, *registry));
+        int num_entries = entries->size();
+        if (state_id >= num_entries) {
+            return ConstArrayView<Element>(
+                default_array.data(), default_array.size());
+        }
+        return ConstArrayView<Element>((*entries)[state_id], default_array.size());
     }
 
     virtual void notify_service_destroyed(const StateRegistry *registry) override {
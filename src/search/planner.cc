@@ -6,6 +6,7 @@
 #include "tasks/root_task.h"
 #include "task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "utils/profiling.h"
 #include "utils/system.h"
 #include "utils/timer.h"
 
@@ -27,6 +28,15 @@ int main(int argc, const char **argv) {
         utils::g_log << "reading input..." << endl;
         tasks::read_root_task(cin);
         utils::g_log << "done reading input!" << endl;
+        if (static_cast<string>(argv[1]) == "--write-binary-task") {
+            if (argc != 3) {
+                cerr << "missing filename after --write-binary-task" << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+            tasks::write_root_task_in_binary_format(argv[2]);
+            utils::g_log << "wrote binary task to " << argv[2] << endl;
+            utils::exit_with(ExitCode::SUCCESS);
+        }
         TaskProxy task_proxy(*tasks::g_root_task);
         unit_cost = task_properties::is_unit_cost(task_proxy);
     }
@@ -59,6 +69,7 @@ int main(int argc, const char **argv) {
 
     engine->save_plan_if_necessary();
     engine->print_statistics();
+    utils::print_profile();
     utils::g_log << "Search time: " << search_timer << endl;
     utils::g_log << "Total time: " << utils::g_timer << endl;
 
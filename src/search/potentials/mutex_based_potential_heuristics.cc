@@ -5,10 +5,12 @@
 #include "mutexes.h"
 #include "util.h"
 
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <set>
-#include <map>
 
 using namespace std;
 using Tuple = vector<FactPair>;
@@ -21,130 +23,183 @@ namespace potentials {
      * @param variable_id the id of the variable
      * @return whether this variables is assigned
      */
-    static bool unassigned(map<int, int> &state, int variable_id) {
-        return state.find(variable_id) == state.end();
+    static bool unassigned(const vector<int> &state, int variable_id) {
+        return state[variable_id] == -1;
     }
 
     /**
-      * Extend the partial state to all possible states with k more assigned values
-      * @param state vector containing the facts of a partial state
-      * @param k amount of remaining variables to assign
-      * @param assigned vector of variable ids which were assigned from the beginning
-      * @param domains domains of all variables
-      * @param extended the states which have been extended so far
-      * @return a vector of all extended vectors
-      */
-    static vector<map<int, int>>
-    get_all_extensions(map<int, int> &state, int k, int last_assigned, vector<int> &assigned,
-                       vector<vector<int>> &domains, vector<map<int, int>> &extended) {
-        if (k == 0) {
-            extended.push_back(state);  // Add the state to the list, if it is fully extended.
-            return extended;
-        }
-
-        // variables assigned from beginning to end, therefore enough unassigned variables need to remain free
-        for (size_t i = last_assigned; i < domains.size(); i++) { //domains.size(), as there are exactly as many domains as variables in the state
-            if (unassigned(state, i)) { // if the variable is unassigned
-                for (int d : domains[i]) {
-                    state[i] = d;               // assign it to all domains and get all extensions
-                    get_all_extensions(state, k - 1, (int) i + 1, assigned, domains, extended);
-                }
-                state.erase(i);                 // unassign the variable
-            }
-        }
-        return extended;
-    }
+     * Compact value arrays of the unassigned variables with their remaining domains, which are reused for all
+     * extensions of one partial state.
+     */
+    struct ExtensionCandidates {
+        vector<int> variables;      // unassigned variables
+        vector<int> value_offsets;  // values of variables[j] are values[value_offsets[j]..value_offsets[j + 1])
+        vector<int> values;
+    };
 
     /**
-      * Extend the partial state to all possible states with k more assigned values
-      * @param state vector containing the facts of a partial state
-      * @param task
-      * @param k amount of remaining variables to assign
-      * @param domains domains of all variables
-      * @return a vector of all extended states as vectors of facts
-      */
-    static vector<map<int, int>>
-    get_all_extensions(map<int, int> &state, int k, vector<vector<int>> &domains) {
-        vector<map<int, int>> states;
-        if (k <= 0) {
-            states.push_back(state);
-            return states;
-        }
-        states.reserve(min(domains.size() * domains[0].size() * k, states.max_size()));
-        vector<int> variables;
-        variables.reserve(state.size());
-        for (auto s : state) {
-            variables.push_back(s.first);
+     * Evaluate the product of the sizes of all disambiguated domains for one (extended) state
+     * @param state the state
+     * @param table the mutex table of this task
+     * @param domains reused to store the disambiguated domains
+     * @return the product of the number of reachable facts of all variables
+     */
+    static long double count_reachable_facts(const vector<int> &state, const MutexTable &table,
+                                             MutexTable::Domains &domains) {
+        table.multi_fact_disambiguation(state, domains);
+        if (domains.is_dead_end()) return 0;
+        long double mult = 1;
+        for (size_t v = 0; v < state.size(); v++) {
+            mult *= domains.get_size(v);
+            if (mult == 0) break;
         }
-        return get_all_extensions(state, k, 0, variables, domains, states);
+        return mult;
     }
 
     /**
      * Calculate C^k_f(M) for one state, as it handles a list of states it can also be used for K_f
      * it is the sum [ of the products [ of the number of reachable facts ] over all variables ] over all (k-extended) states
-     * @param states the extensions of the state of interest (P^{f}_k resp. P^(tU{f})_(|t|+k))
-     * @param variables the variables of this task
-     * @param mutexes the set of mutexes for this task
-     * @return the sum over the product of all reachable facts of each state
+     * The extensions are not materialized: they are walked in place by choosing k of the unassigned variables
+     * (in increasing order) and, for each choice, counting through all combinations of their values like an odometer.
+     * @param state the state of interest (p U {f}), which is restored before returning
+     * @param k amount of variables to extend
+     * @param domains the disambiguated domains of the state
+     * @param table the mutex table of this task
+     * @param candidates reused to store the values of the unassigned variables
+     * @param chosen reused to store the positions of the chosen variables in candidates
+     * @param digits reused to store the value positions of the chosen variables
+     * @param extension_domains reused to store the disambiguated domains of each extension
+     * @return the sum over the product of all reachable facts of each extended state
      */
-    static long double c_k_f(vector<map<int, int>> &states, MutexTable &table) {
+    static long double c_k_f(vector<int> &state, int k, const MutexTable::Domains &domains, const MutexTable &table,
+                             ExtensionCandidates &candidates, vector<int> &chosen, vector<int> &digits,
+                             MutexTable::Domains &extension_domains) {
+        if (k <= 0) {
+            return count_reachable_facts(state, table, extension_domains);
+        }
+
+        const VariablesProxy &variables = *table.getVariablesProxy();
+        candidates.variables.clear();
+        candidates.value_offsets.clear();
+        candidates.values.clear();
+        for (size_t i = 0; i < state.size(); i++) {
+            if (unassigned(state, i)) {
+                candidates.variables.push_back(i);
+                candidates.value_offsets.push_back(candidates.values.size());
+                for (int d = 0; d < variables[i].get_domain_size(); d++) {
+                    if (domains.contains(i, d)) {
+                        candidates.values.push_back(d);
+                    }
+                }
+            }
+        }
+        candidates.value_offsets.push_back(candidates.values.size());
+        int num_candidates = candidates.variables.size();
+        if (k > num_candidates) return 0;
+
         long double sum = 0;
-        long double mult;
-        for (map<int, int> &e : states) {
-            mult = 1;
-            vector<vector<int>> domains = table.multi_fact_disambiguation(e);
-            for (const vector<int> &d : domains) {
-                mult *= d.size();
-                if (mult == 0) break;
+        chosen.resize(k);
+        digits.resize(k);
+        for (int j = 0; j < k; j++) {
+            chosen[j] = j;
+        }
+        while (true) {
+            // Assign the first value to all chosen variables ...
+            for (int j = 0; j < k; j++) {
+                digits[j] = 0;
+                state[candidates.variables[chosen[j]]] = candidates.values[candidates.value_offsets[chosen[j]]];
+            }
+            // ... and count through all value combinations, the last chosen variable changing fastest.
+            while (true) {
+                sum += count_reachable_facts(state, table, extension_domains);
+                int j = k - 1;
+                for (; j >= 0; j--) {
+                    int c = chosen[j];
+                    int offset = candidates.value_offsets[c];
+                    int size = candidates.value_offsets[c + 1] - offset;
+                    if (++digits[j] < size) {
+                        state[candidates.variables[c]] = candidates.values[offset + digits[j]];
+                        break;
+                    }
+                    digits[j] = 0;
+                    state[candidates.variables[c]] = candidates.values[offset];
+                }
+                if (j < 0) break;
+            }
+            for (int j = 0; j < k; j++) {
+                state[candidates.variables[chosen[j]]] = -1;
+            }
+
+            // Choose the next k variables.
+            int j = k - 1;
+            while (j >= 0 && chosen[j] == num_candidates - k + j) j--;
+            if (j < 0) break;
+            chosen[j]++;
+            for (int l = j + 1; l < k; l++) {
+                chosen[l] = chosen[l - 1] + 1;
             }
-            sum += mult;
         }
         return sum;
     }
 
     /**
       * Calculates the weights of all facts for all states (Eq. 12)
+      * The weights of the facts are independent of each other and computed in parallel.
       * @param k amount of variables to extend
-      * @param variables all variables
-      * @param mutexes all mutex facts
-      * @param task the task
-      * @return a vector containing for each state (outer vector) the weights of each fact (inner vectors)
+      * @param assigned_variables the partial state, -1 for unassigned variables
+      * @param table the mutex table of this task
+      * @param pool threads used to compute the weights
+      * @return a vector containing the weights of all facts of the unassigned variables
       */
     static vector<Weight>
-    opt_k_m(int k, map<int, int> &assigned_variables, MutexTable &table) {
+    opt_k_m(int k, const vector<int> &assigned_variables, const MutexTable &table, utils::ThreadPool &pool) {
         const VariablesProxy *variables = table.getVariablesProxy();
-        vector<Weight> facts;               // vector containing facts and their corresponding weight.
-        facts.reserve(min(variables->size() * variables->operator[](0).get_domain_size(), facts.max_size()));
-        vector<Weight> weights_f;           // to temporarily store the c_k_f values of one variable
-        vector<map<int, int >> states;      // to temporarily store the extended states of a fact
-        vector<vector<int>> domains;        // temporarily contain the multi_fact_disambiguated domain with one fact
-        long double w, sum;
-
-        for (size_t i = 0; i < variables->size(); i++) {         // for all all unassigned variables V and each fact_V
+        vector<FactPair> candidate_facts;   // all facts of unassigned variables
+        for (size_t i = 0; i < variables->size(); i++) {
             if (unassigned(assigned_variables, (int) i)) {
-                sum = 0;
-                weights_f.clear();
                 for (int d = 0; d < variables->operator[](i).get_domain_size(); d++) {
-                    assigned_variables[i] = d;                          // add this fact
-                    domains = table.multi_fact_disambiguation(assigned_variables);    // get all non-mutex domains
-                    if (domains[0].empty()) continue;                   // partial state is a dead end
-                    states = get_all_extensions(assigned_variables, k - 1,
-                                                domains);           // get all extended states for this fact
-                    // (k - 1, as one additional variables is already assigned)
-                    w = c_k_f(states, table);                    // Get the non-normalized weight of this fact ...
-                    states.clear();
-                    weights_f.emplace_back(i, d, w);                    // and add it to the list.
-                    sum += w;
+                    candidate_facts.emplace_back(i, d);
                 }
+            }
+        }
 
-                // normalize all weights
-                for (auto &d : weights_f) {
-                    get<2>(d) = get<2>(d) / sum;
-                    facts.push_back(d);
+        // Get the non-normalized weight of each fact, negative for facts which are dead ends.
+        vector<long double> weights(candidate_facts.size());
+        pool.parallel_for(candidate_facts.size(), [&](int begin, int end) {
+            vector<int> state = assigned_variables;
+            MutexTable::Domains domains(table); // the multi_fact_disambiguated domain with one fact
+            MutexTable::Domains extension_domains(table);
+            ExtensionCandidates candidates;
+            vector<int> chosen;
+            vector<int> digits;
+            for (int f = begin; f < end; f++) {
+                const FactPair &fact = candidate_facts[f];
+                state[fact.var] = fact.value;                       // add this fact
+                table.multi_fact_disambiguation(state, domains);    // get all non-mutex domains
+                if (domains.is_dead_end()) {                        // partial state is a dead end
+                    weights[f] = -1;
+                } else {
+                    // (k - 1, as one additional variables is already assigned)
+                    weights[f] = c_k_f(state, k - 1, domains, table, candidates, chosen, digits,
+                                       extension_domains);
                 }
+                state[fact.var] = -1;
+            }
+        });
 
-                // remove state[i]
-                assigned_variables.erase(assigned_variables.find(i));
+        vector<Weight> facts;               // vector containing facts and their corresponding weight.
+        facts.reserve(candidate_facts.size());
+        size_t f = 0;
+        while (f < candidate_facts.size()) {
+            // normalize all weights of one variable
+            int var = candidate_facts[f].var;
+            size_t var_begin = f;
+            long double sum = 0;
+            for (; f < candidate_facts.size() && candidate_facts[f].var == var; f++) {
+                if (weights[f] >= 0) sum += weights[f];
+            }
+            for (size_t g = var_begin; g < f; g++) {
+                if (weights[g] >= 0) facts.emplace_back(var, candidate_facts[g].value, weights[g] / sum);
             }
         }
         return facts;
@@ -153,15 +208,14 @@ namespace potentials {
     /**
       * Calculates the weights of all facts for all states (Eq. 12)
       * @param k amount of variables to extend
-      * @param variables all variables
-      * @param mutexes all mutex facts
-      * @param task the task
-      * @return a vector containing for each state (outer vector) the weights of each fact (inner vectors)
+      * @param table the mutex table of this task
+      * @param pool threads used to compute the weights
+      * @return a vector containing the weights of all facts
       */
-    static vector<Weight> opt_k_m(int k, MutexTable &table) {
+    static vector<Weight> opt_k_m(int k, const MutexTable &table, utils::ThreadPool &pool) {
         utils::g_log << "Using Mutex Based Potential Heuristics." << endl;
-        map<int, int> assigned_variables;   // to temporarily store one 'state'
-        return opt_k_m(k, assigned_variables, table);
+        vector<int> assigned_variables(table.getVariablesProxy()->size(), -1);   // to temporarily store one 'state'
+        return opt_k_m(k, assigned_variables, table, pool);
     }
 
     /**
@@ -172,10 +226,11 @@ namespace potentials {
      * @param variables
      * @param mutexes
      * @param optimizer
+     * @param pool threads used to compute the weights
      * @return
      */
     static vector<unique_ptr<PotentialFunction>>
-    opt_t_k_m(int t, int k, int n, MutexTable table, PotentialOptimizer &optimizer) {
+    opt_t_k_m(int t, int k, int n, const MutexTable &table, PotentialOptimizer &optimizer, utils::ThreadPool &pool) {
         utils::g_log << "Using Mutex Based Potential Ensemble Heuristics." << endl;
         const VariablesProxy *variables = table.getVariablesProxy();
         random_device rd;
@@ -185,10 +240,10 @@ namespace potentials {
         // generate n optimization functions for one randomly sampled state
         vector<unique_ptr<PotentialFunction>> functions;
         vector<Weight> weights;
-        map<int, int> state;
+        vector<int> state(variables->size());
         int i = 0;
         while (i < n) {
-            state.clear();
+            fill(state.begin(), state.end(), -1);
             for (int t_i = 0; t_i < t; t_i++) {
                 int v = dist_v(gen);
                 if (unassigned(state, v)) {
@@ -196,7 +251,7 @@ namespace potentials {
                     state[v] = dist_f(gen);
                 } else t_i--;
             }
-            weights = opt_k_m(k - t, state, table);
+            weights = opt_k_m(k - t, state, table, pool);
             if (!weights.empty()) {
                 i++;
                 optimizer.optimize_for_weighted_samples(weights);
@@ -221,7 +276,8 @@ namespace potentials {
 
         int k = opts.get<int>("k");
         assert(k < (int) variables.size()); // k may not be bigger than the size of one state
-        vector<Weight> weights = opt_k_m(k, *table);
+        utils::ThreadPool pool(opts.get<int>("threads"));
+        vector<Weight> weights = opt_k_m(k, *table, pool);
         optimizer.optimize_for_weighted_samples(weights);
         return optimizer.get_potential_function();
     }
@@ -244,7 +300,8 @@ namespace potentials {
         assert(t <= k);                     // t may not be bigger than k
         int n = opts.get<int>("n");
 
-        return opt_t_k_m(t, k, n, *table, optimizer);
+        utils::ThreadPool pool(opts.get<int>("threads"));
+        return opt_t_k_m(t, k, n, *table, optimizer, pool);
     }
 
     static shared_ptr<Heuristic> _parse_single(OptionParser &parser) {
@@ -271,6 +328,11 @@ namespace potentials {
                 "size of extended state",
                 "1",
                 Bounds("0", "infinity"));
+        parser.add_option<int>(
+                "threads",
+                "number of threads for computing the fact weights",
+                "1",
+                Bounds("1", "infinity"));
         prepare_parser_for_admissible_potentials(parser);
         Options opts = parser.parse();
         if (parser.dry_run())
@@ -314,6 +376,11 @@ namespace potentials {
                 "Number of states to sample",
                 "50",
                 Bounds("0", "infinity"));
+        parser.add_option<int>(
+                "threads",
+                "number of threads for computing the fact weights",
+                "1",
+                Bounds("1", "infinity"));
         prepare_parser_for_admissible_potentials(parser);
         Options opts = parser.parse();
         utils::add_rng_options(parser);
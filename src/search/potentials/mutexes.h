@@ -10,7 +10,9 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../heuristic.h" // something here includes utils::log
+#include "../heuristics/hm_table.h"
 
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -25,45 +27,76 @@ namespace options {
     class Options;
 }
 
+/**
+ * Pairwise mutexes of a task, computed with h^2 from the initial state.
+ *
+ * Facts are numbered consecutively variable by variable, so the facts of
+ * one variable form a contiguous range of bits. Row f of the mutex matrix
+ * is a bitset over all facts containing the facts that are mutex with f.
+ * Disambiguation then only needs word-wide ANDs and ORs of such rows.
+ */
 class MutexTable {
-
-    using Pair = std::pair<FactPair, FactPair>;
+public:
+    /**
+     * Result of multi_fact_disambiguation: the remaining domains of all
+     * variables as one bitset over all facts. Create it once and reuse it
+     * for many calls, which then do not allocate memory.
+     */
+    class Domains {
+        friend class MutexTable;
+
+        const MutexTable &table;
+        vector<uint64_t> facts;
+        vector<uint64_t> mutex_facts;   // facts that are mutex with the current partial state
+        vector<uint64_t> intersection;  // scratch space
+        bool dead_end;
+
+    public:
+        explicit Domains(const MutexTable &table);
+
+        bool is_dead_end() const {
+            return dead_end;
+        }
+
+        bool contains(int variable_id, int value) const {
+            return test_bit(facts, table.fact_offsets[variable_id] + value);
+        }
+
+        int get_size(int variable_id) const;
+    };
 
 private:
-    vector<Pair> mutexes;
     VariablesProxy variables;
     TaskProxy task_proxy;
-    std::map<Pair, int> hm_table;
-    bool was_updated = false;
-
-    void generate_all_pairs(); // recursively generate all tuples.
-    static vector<Pair> generate_all_pairs(vector<FactPair> &tuples); // generate all pairs.
-
-    void init_hm_table(vector<FactPair> &t);
-
-    void update_hm_table();
-
-    bool all_reachable(vector<FactPair> &t);
-
-    void extend_fact(const FactPair &fact, const vector<FactPair> &pre, const set<int> &eff_vars);
-
-    static bool unassigned(map<int, int> &state, int variable_id);
-
-    static vector<int> set_minus(const vector<int> &domain, const vector<FactPair> &mutex, int variable_id);
+    int num_facts;
+    int num_words;
+    vector<int> fact_offsets;
+    vector<uint64_t> mutex_matrix;
 
-    static vector<FactPair> intersection(const vector<FactPair> &one, const vector<FactPair> &two);
+    static bool test_bit(const vector<uint64_t> &bits, int index) {
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
 
-    vector<FactPair> get_mutex_with_state(map<int, int> &state);
+    static void set_bit(vector<uint64_t> &bits, int index) {
+        bits[index / 64] |= uint64_t(1) << (index % 64);
+    }
 
-    void get_mutex_with_fact(int variable, int value, vector<FactPair> &mf);
+    const uint64_t *get_mutex_row(int fact) const {
+        return &mutex_matrix[static_cast<size_t>(fact) * num_words];
+    }
 
-    bool reachable_from(const vector<FactPair> &vector, FactPair pair);
+    bool restrict_domain(int variable_id, Domains &domains) const;
 
 public:
     explicit MutexTable(TaskProxy task_proxy);
 
-    vector<vector<int>>
-    multi_fact_disambiguation(map<int, int> &state);
+    /**
+     * Shrink the domains of all unassigned variables by removing facts that
+     * are mutex with the partial state, until nothing changes anymore.
+     * @param state value of each variable, or -1 for unassigned variables
+     * @param domains receives the remaining domains
+     */
+    void multi_fact_disambiguation(const vector<int> &state, Domains &domains) const;
 
     const VariablesProxy *getVariablesProxy() const;
 
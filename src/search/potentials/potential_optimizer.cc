@@ -338,13 +338,12 @@ void PotentialOptimizer::construct_mutex_lp() {
     /* Create full goal state. Use value |dom(V)| as "undefined" value
        for variables V undefined in the goal. */
     vector<int> goal(task_proxy.get_variables().size(), -1);
-    map<int, int> goal_map;
     for (FactProxy fact : task_proxy.get_goals()) {
         goal[fact.get_variable().get_id()] = fact.get_value();
-        goal_map[fact.get_variable().get_id()] = fact.get_value();
     }
-    vector<vector<int>> domains = table->multi_fact_disambiguation(goal_map);
-    if (domains[0].empty()) {
+    MutexTable::Domains domains(*table);
+    table->multi_fact_disambiguation(goal, domains);
+    if (domains.is_dead_end()) {
         // problem unsolvable, if goal-state it contains a mutex.
         utils::exit_with(ExitCode::SEARCH_UNSOLVABLE);
     }
@@ -362,7 +361,9 @@ void PotentialOptimizer::construct_mutex_lp() {
         lp_var.upper_bound = 0;
 
         int undef_val_lp = lp_var_ids[var_id][get_undefined_value(var)];
-        for (int val : domains[var_id]) {
+        for (int val = 0; val < var.get_domain_size(); ++val) {
+            if (!domains.contains(var_id, val))
+                continue;
             int val_lp = lp_var_ids[var_id][val];
             /*
              Create constraint (using variable bounds): P_{V=goal[V]} = 0
@@ -381,13 +382,16 @@ void PotentialOptimizer::construct_mutex_lp() {
     }
 
     // add constraints for U_E^o_V
+    vector<int> pre(task_proxy.get_variables().size(), -1);
     for (OperatorProxy o : task_proxy.get_operators()) {
-        map<int, int> pre;
         for(FactProxy fact : o.get_preconditions()) {
             pre[fact.get_variable().get_id()] = fact.get_value();
         }
-        domains = table->multi_fact_disambiguation(pre);
-        if (domains[0].empty()) {
+        table->multi_fact_disambiguation(pre, domains);
+        for(FactProxy fact : o.get_preconditions()) {
+            pre[fact.get_variable().get_id()] = -1;
+        }
+        if (domains.is_dead_end()) {
             // if a precondition contains a mutex, this operation will never be on any reachable path.
             continue;
         }
@@ -395,7 +399,9 @@ void PotentialOptimizer::construct_mutex_lp() {
             int var_id = var.get_id();
 
             int undef_val_lp = lp_var_ids[var_id][get_undefined_value_for_operator(var, o)];
-            for (int val : domains[var_id]) {
+            for (int val = 0; val < var.get_domain_size(); ++val) {
+                if (!domains.contains(var_id, val))
+                    continue;
                 int val_lp = lp_var_ids[var_id][val];
                 // Create constraint: P_{V=v} <= P_{V=u}
                 // Note that we could eliminate variables P_{V=u} if V is
@@ -3,6 +3,8 @@
 #include "global_state.h"
 #include "plugin.h"
 
+#include "utils/profiling.h"
+
 #include <cassert>
 
 using namespace std;
@@ -19,6 +21,7 @@ void PruningMethod::initialize(const shared_ptr<AbstractTask> &task_) {
 // TODO remove this overload once the search uses the task interface.
 void PruningMethod::prune_operators(const GlobalState &global_state,
                                     vector<OperatorID> &op_ids) {
+    PROFILE_SCOPE("PruningMethod::prune_operators");
     assert(task);
     /* Note that if the pruning method would use a different task than
        the search, we would have to convert the state before using it. */
@@ -11,6 +11,7 @@
 #include "tasks/root_task.h"
 #include "utils/countdown_timer.h"
 #include "utils/logging.h"
+#include "utils/memory.h"
 #include "utils/rng_options.h"
 #include "utils/system.h"
 #include "utils/timer.h"
@@ -24,12 +25,15 @@ using utils::ExitCode;
 
 class PruningMethod;
 
-successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy &task_proxy) {
+successor_generator::SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, successor_generator::SuccessorGeneratorType type) {
     utils::g_log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        (type == successor_generator::SuccessorGeneratorType::FLAT)
+        ? successor_generator::g_flat_successor_generators[task_proxy]
+        : successor_generator::g_successor_generators[task_proxy];
     successor_generator_timer.stop();
     utils::g_log << "done!" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -46,9 +50,14 @@ SearchEngine::SearchEngine(const Options &opts)
       solution_found(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy)),
-      search_space(state_registry),
+      state_registry(task_proxy, opts.get<bool>("compress_states", false)),
+      successor_generator(get_successor_generator(
+                              task_proxy,
+                              opts.get<successor_generator::SuccessorGeneratorType>(
+                                  "successor_generator",
+                                  successor_generator::SuccessorGeneratorType::TREE))),
+      search_space(state_registry, opts.get<OperatorCost>("cost_type"),
+                   opts.get<bool>("store_parents", true)),
       search_progress(opts.get<utils::Verbosity>("verbosity")),
       statistics(opts.get<utils::Verbosity>("verbosity")),
       cost_type(opts.get<OperatorCost>("cost_type")),
@@ -60,6 +69,14 @@ SearchEngine::SearchEngine(const Options &opts)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
     bound = opts.get<int>("bound");
+    StatisticsFormat statistics_format =
+        opts.get<StatisticsFormat>("statistics_format", StatisticsFormat::NONE);
+    if (statistics_format != StatisticsFormat::NONE) {
+        statistics_stream = utils::make_unique_ptr<SearchStatisticsStream>(
+            statistics_format, opts.get<string>("statistics_file"),
+            opts.get<double>("statistics_interval"));
+        statistics.set_measure_evaluator_times(true);
+    }
     task_properties::print_variable_statistics(task_proxy);
 }
 
@@ -89,12 +106,19 @@ void SearchEngine::search() {
     utils::CountdownTimer timer(max_time);
     while (status == IN_PROGRESS) {
         status = step();
-        if (timer.is_expired()) {
+        if (statistics_stream && statistics_stream->is_report_due()) {
+            statistics_stream->report(statistics, state_registry, get_open_list_size());
+        }
+        // Do not discard the result of a step that ends the search.
+        if (status == IN_PROGRESS && timer.is_expired()) {
             utils::g_log << "Time limit reached. Abort search." << endl;
             status = TIMEOUT;
             break;
         }
     }
+    if (statistics_stream) {
+        statistics_stream->report(statistics, state_registry, get_open_list_size());
+    }
     // TODO: Revise when and which search times are logged.
     utils::g_log << "Actual search time: " << timer.get_elapsed_time() << endl;
 }
@@ -149,6 +173,57 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    vector<string> successor_generator_types;
+    vector<string> successor_generator_types_doc;
+    successor_generator_types.push_back("TREE");
+    successor_generator_types_doc.push_back(
+        "decision tree of polymorphic nodes");
+    successor_generator_types.push_back("FLAT");
+    successor_generator_types_doc.push_back(
+        "the same decision tree compiled into a flat array of ints that "
+        "is traversed without virtual calls and reads packed states "
+        "directly");
+    parser.add_enum_option<successor_generator::SuccessorGeneratorType>(
+        "successor_generator",
+        successor_generator_types,
+        "representation of the successor generator used for expanding states",
+        "TREE",
+        successor_generator_types_doc);
+    parser.add_option<bool>(
+        "compress_states",
+        "store registered states with tree compression, i.e., share equal "
+        "parts of the packed state data between states. This reduces the "
+        "memory of the state registry for tasks with many state variables "
+        "at the cost of slower state registration and lookup.",
+        "false");
+    vector<string> statistics_formats;
+    vector<string> statistics_formats_doc;
+    statistics_formats.push_back("NONE");
+    statistics_formats_doc.push_back("do not write periodic statistics");
+    statistics_formats.push_back("JSON");
+    statistics_formats_doc.push_back("one JSON object per line");
+    statistics_formats.push_back("CSV");
+    statistics_formats_doc.push_back("comma-separated values with a header line");
+    parser.add_enum_option<StatisticsFormat>(
+        "statistics_format",
+        statistics_formats,
+        "format of the search statistics (counters, throughput, open list "
+        "size, state registry memory and time per evaluator) that are "
+        "written periodically to statistics_file. Measuring the time per "
+        "evaluator adds a small overhead to every evaluation.",
+        "NONE",
+        statistics_formats_doc);
+    parser.add_option<string>(
+        "statistics_file",
+        "file for the periodic search statistics. Use /dev/stderr or "
+        "/dev/fd/N to write to a file descriptor.",
+        "search_statistics");
+    parser.add_option<double>(
+        "statistics_interval",
+        "seconds between two records of the periodic search statistics. "
+        "A final record is written when the search ends.",
+        "10",
+        Bounds("0.0", "infinity"));
     utils::add_verbosity_option_to_parser(parser);
 }
 
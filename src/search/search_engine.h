@@ -7,9 +7,11 @@
 #include "search_progress.h"
 #include "search_space.h"
 #include "search_statistics.h"
+#include "search_statistics_stream.h"
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include <memory>
 #include <vector>
 
 namespace options {
@@ -53,10 +55,16 @@ protected:
     bool is_unit_cost;
     double max_time;
     const utils::Verbosity verbosity;
+    std::unique_ptr<SearchStatisticsStream> statistics_stream;
 
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
 
+    // Return the number of open entries for reporting, or -1 if unknown.
+    virtual int get_open_list_size() const {
+        return -1;
+    }
+
     void set_plan(const Plan &plan);
     bool check_goal_and_set_plan(const GlobalState &state);
     int get_adjusted_cost(const OperatorProxy &op) const;
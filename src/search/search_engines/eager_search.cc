@@ -9,6 +9,7 @@
 #include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
 
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 
 #include <cassert>
@@ -23,6 +24,7 @@ namespace eager_search {
 EagerSearch::EagerSearch(const Options &opts)
     : SearchEngine(opts),
       reopen_closed_nodes(opts.get<bool>("reopen_closed")),
+      batch_successors(opts.get<bool>("batch_successors")),
       open_list(opts.get<shared_ptr<OpenListFactory>>("open")->
                 create_state_open_list()),
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
@@ -72,6 +74,12 @@ void EagerSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    if (batch_successors) {
+        set<Evaluator *> open_list_evals;
+        open_list->get_evaluators(open_list_evals);
+        batch_evaluators.assign(open_list_evals.begin(), open_list_evals.end());
+    }
+
     const GlobalState &initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -194,6 +202,11 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
+    if (batch_successors) {
+        generate_successors_in_batch(*node, applicable_ops, preferred_operators);
+        return IN_PROGRESS;
+    }
+
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node->get_real_g() + op.get_cost()) >= bound)
@@ -238,52 +251,159 @@ SearchStatus EagerSearch::step() {
                 statistics.print_checkpoint_line(succ_node.get_g());
                 reward_progress();
             }
-        } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
-            // We found a new cheapest path to an open or closed state.
-            if (reopen_closed_nodes) {
-                if (succ_node.is_closed()) {
-                    /*
-                      TODO: It would be nice if we had a way to test
-                      that reopening is expected behaviour, i.e., exit
-                      with an error when this is something where
-                      reopening should not occur (e.g. A* with a
-                      consistent heuristic).
-                    */
-                    statistics.inc_reopened();
-                }
-                succ_node.reopen(*node, op, get_adjusted_cost(op));
+        } else {
+            handle_known_successor(*node, succ_node, succ_state, op, is_preferred);
+        }
+    }
 
-                EvaluationContext succ_eval_context(
-                    succ_state, succ_node.get_g(), is_preferred, &statistics);
+    return IN_PROGRESS;
+}
 
+void EagerSearch::handle_known_successor(
+    const SearchNode &node, SearchNode &succ_node,
+    const GlobalState &succ_state, const OperatorProxy &op,
+    bool is_preferred) {
+    if (succ_node.get_g() > node.get_g() + get_adjusted_cost(op)) {
+        // We found a new cheapest path to an open or closed state.
+        if (reopen_closed_nodes) {
+            if (succ_node.is_closed()) {
                 /*
-                  Note: our old code used to retrieve the h value from
-                  the search node here. Our new code recomputes it as
-                  necessary, thus avoiding the incredible ugliness of
-                  the old "set_evaluator_value" approach, which also
-                  did not generalize properly to settings with more
-                  than one evaluator.
-
-                  Reopening should not happen all that frequently, so
-                  the performance impact of this is hopefully not that
-                  large. In the medium term, we want the evaluators to
-                  remember evaluator values for states themselves if
-                  desired by the user, so that such recomputations
-                  will just involve a look-up by the Evaluator object
-                  rather than a recomputation of the evaluator value
-                  from scratch.
+                  TODO: It would be nice if we had a way to test
+                  that reopening is expected behaviour, i.e., exit
+                  with an error when this is something where
+                  reopening should not occur (e.g. A* with a
+                  consistent heuristic).
                 */
-                open_list->insert(succ_eval_context, succ_state.get_id());
+                statistics.inc_reopened();
+            }
+            succ_node.reopen(node, op, get_adjusted_cost(op));
+
+            EvaluationContext succ_eval_context(
+                succ_state, succ_node.get_g(), is_preferred, &statistics);
+
+            /*
+              Note: our old code used to retrieve the h value from
+              the search node here. Our new code recomputes it as
+              necessary, thus avoiding the incredible ugliness of
+              the old "set_evaluator_value" approach, which also
+              did not generalize properly to settings with more
+              than one evaluator.
+
+              Reopening should not happen all that frequently, so
+              the performance impact of this is hopefully not that
+              large. In the medium term, we want the evaluators to
+              remember evaluator values for states themselves if
+              desired by the user, so that such recomputations
+              will just involve a look-up by the Evaluator object
+              rather than a recomputation of the evaluator value
+              from scratch.
+            */
+            open_list->insert(succ_eval_context, succ_state.get_id());
+        } else {
+            // If we do not reopen closed nodes, we just update the parent pointers.
+            // Note that this could cause an incompatibility between
+            // the g-value and the actual path that is traced back.
+            succ_node.update_parent(node, op, get_adjusted_cost(op));
+        }
+    }
+}
+
+void EagerSearch::generate_successors_in_batch(
+    const SearchNode &node, const vector<OperatorID> &applicable_ops,
+    const ordered_set::OrderedSet<OperatorID> &preferred_operators) {
+    GlobalState s = node.get_state();
+    OperatorsProxy operators = task_proxy.get_operators();
+
+    batch_ops.clear();
+    for (OperatorID op_id : applicable_ops) {
+        if ((node.get_real_g() + operators[op_id].get_cost()) < bound)
+            batch_ops.push_back(op_id);
+    }
+    batch_successor_ids.clear();
+    state_registry.get_successor_states(s, batch_ops, batch_successor_ids);
+    statistics.inc_generated(batch_ops.size());
+
+    /*
+      Handle successors that we have seen before right away and collect
+      the new ones. If a new state is reached by several operators, we
+      only keep the cheapest of them.
+    */
+    struct NewSuccessor {
+        int batch_index;
+        bool is_preferred;
+    };
+    vector<NewSuccessor> new_successors;
+    utils::HashMap<StateID, int> new_successor_indices;
+    for (size_t i = 0; i < batch_ops.size(); ++i) {
+        OperatorID op_id = batch_ops[i];
+        GlobalState succ_state = state_registry.lookup_state(batch_successor_ids[i]);
+        bool is_preferred = preferred_operators.contains(op_id);
+        SearchNode succ_node = search_space.get_node(succ_state);
+
+        for (Evaluator *evaluator : path_dependent_evaluators) {
+            evaluator->notify_state_transition(s, op_id, succ_state);
+        }
+
+        // Previously encountered dead end. Don't re-evaluate.
+        if (succ_node.is_dead_end())
+            continue;
+
+        if (succ_node.is_new()) {
+            auto result = new_successor_indices.emplace(
+                succ_state.get_id(), new_successors.size());
+            if (result.second) {
+                new_successors.push_back({static_cast<int>(i), is_preferred});
             } else {
-                // If we do not reopen closed nodes, we just update the parent pointers.
-                // Note that this could cause an incompatibility between
-                // the g-value and the actual path that is traced back.
-                succ_node.update_parent(*node, op, get_adjusted_cost(op));
+                NewSuccessor &entry = new_successors[result.first->second];
+                if (get_adjusted_cost(operators[op_id]) <
+                    get_adjusted_cost(operators[batch_ops[entry.batch_index]])) {
+                    entry.batch_index = i;
+                }
+                entry.is_preferred = entry.is_preferred || is_preferred;
             }
+        } else {
+            handle_known_successor(
+                node, succ_node, succ_state, operators[op_id], is_preferred);
         }
     }
 
-    return IN_PROGRESS;
+    // Evaluate all new successors together.
+    vector<EvaluationContext> eval_contexts;
+    eval_contexts.reserve(new_successors.size());
+    vector<EvaluationContext *> batch;
+    batch.reserve(new_successors.size());
+    for (const NewSuccessor &entry : new_successors) {
+        OperatorProxy op = operators[batch_ops[entry.batch_index]];
+        int succ_g = node.get_g() + get_adjusted_cost(op);
+        eval_contexts.emplace_back(
+            state_registry.lookup_state(batch_successor_ids[entry.batch_index]),
+            succ_g, entry.is_preferred, &statistics);
+        batch.push_back(&eval_contexts.back());
+    }
+    statistics.inc_evaluated_states(new_successors.size());
+    for (Evaluator *evaluator : batch_evaluators) {
+        EvaluationContext::evaluate_batch(evaluator, batch);
+    }
+
+    for (size_t i = 0; i < new_successors.size(); ++i) {
+        EvaluationContext &succ_eval_context = eval_contexts[i];
+        OperatorProxy op = operators[batch_ops[new_successors[i].batch_index]];
+        const GlobalState &succ_state = succ_eval_context.get_state();
+        SearchNode succ_node = search_space.get_node(succ_state);
+
+        if (open_list->is_dead_end(succ_eval_context)) {
+            succ_node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+            continue;
+        }
+        succ_node.open(node, op, get_adjusted_cost(op));
+
+        open_list->insert(succ_eval_context, succ_state.get_id());
+        if (search_progress.check_progress(succ_eval_context)) {
+            statistics.print_checkpoint_line(succ_node.get_g());
+            reward_progress();
+        }
+    }
 }
 
 void EagerSearch::reward_progress() {
@@ -313,6 +433,29 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
 }
 
 void add_options_to_parser(OptionParser &parser) {
+    parser.add_option<bool>(
+        "batch_successors",
+        "generate all successors of an expanded state first and then "
+        "evaluate the new ones together as a batch. This can speed up "
+        "evaluators that support batch evaluation. If a new state is "
+        "reached by several operators of the same expansion, only the "
+        "cheapest one is considered.",
+        "false");
+    parser.add_option<bool>(
+        "store_parents",
+        "store the parent state and creating operator of each search node. "
+        "Without them, nodes take less memory and the plan is reconstructed "
+        "after the search by regression from the goal state. For every state "
+        "on the way back, each operator is regressed and the resulting "
+        "predecessors are looked up by hash. If an operator changes "
+        "variables without preconditions, this gives one predecessor for "
+        "each combination of their values. If there are more combinations "
+        "than registered states, the registered states are tested instead. "
+        "Each step thus takes time O(|operators| * min(c, |registered "
+        "states|)), where c is the largest number of combinations. This is "
+        "fast for most tasks, but can be slow for tasks with operators "
+        "that change many variables without preconditions.",
+        "true");
     SearchEngine::add_pruning_option(parser);
     SearchEngine::add_options_to_parser(parser);
 }
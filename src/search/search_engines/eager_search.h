@@ -10,6 +10,11 @@
 class Evaluator;
 class PruningMethod;
 
+namespace ordered_set {
+template<typename T>
+class OrderedSet;
+}
+
 namespace options {
 class OptionParser;
 class Options;
@@ -18,6 +23,7 @@ class Options;
 namespace eager_search {
 class EagerSearch : public SearchEngine {
     const bool reopen_closed_nodes;
+    const bool batch_successors;
 
     std::unique_ptr<StateOpenList> open_list;
     std::shared_ptr<Evaluator> f_evaluator;
@@ -28,6 +34,20 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    // Evaluators of the open list, used to evaluate successors in batches.
+    std::vector<Evaluator *> batch_evaluators;
+    // Scratch space for generate_successors_in_batch.
+    std::vector<OperatorID> batch_ops;
+    std::vector<StateID> batch_successor_ids;
+
+    void handle_known_successor(
+        const SearchNode &node, SearchNode &succ_node,
+        const GlobalState &succ_state, const OperatorProxy &op,
+        bool is_preferred);
+    void generate_successors_in_batch(
+        const SearchNode &node, const std::vector<OperatorID> &applicable_ops,
+        const ordered_set::OrderedSet<OperatorID> &preferred_operators);
+
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
@@ -35,6 +55,9 @@ class EagerSearch : public SearchEngine {
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override {
+        return open_list->get_num_entries();
+    }
 
 public:
     explicit EagerSearch(const options::Options &opts);
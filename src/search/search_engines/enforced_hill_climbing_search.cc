@@ -230,7 +230,7 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
                 if (d_counts.count(d) == 0) {
                     d_counts[d] = make_pair(0, 0);
                 }
-                pair<int, int> &d_pair = d_counts[d];
+                pair<int, int64_t> &d_pair = d_counts[d];
                 d_pair.first += 1;
                 d_pair.second += statistics.get_expanded() - last_num_expanded;
 
@@ -41,9 +41,9 @@ class EnforcedHillClimbingSearch : public SearchEngine {
     int current_phase_start_g;
 
     // Statistics
-    std::map<int, std::pair<int, int>> d_counts;
+    std::map<int, std::pair<int, int64_t>> d_counts;
     int num_ehc_phases;
-    int last_num_expanded;
+    int64_t last_num_expanded;
 
     void insert_successor_into_open_list(
         const EvaluationContext &eval_context,
@@ -59,6 +59,9 @@ class EnforcedHillClimbingSearch : public SearchEngine {
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override {
+        return open_list->get_num_entries();
+    }
 
 public:
     explicit EnforcedHillClimbingSearch(const options::Options &opts);
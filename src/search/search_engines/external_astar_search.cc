@@ -0,0 +1,581 @@
+#include "external_astar_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+
+#include "../algorithms/int_packer.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+#include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+using namespace std;
+
+namespace external_astar_search {
+/*
+  A record consists of the packed state data followed by the fields
+  below, which are stored as PackedStateBin values as well.
+*/
+static const int CREATING_OPERATOR = 0;
+// Index of the layer whose expansion generated the state.
+static const int GENERATING_LAYER = 1;
+static const int REAL_G = 2;
+static const int NUM_RECORD_FIELDS = 3;
+
+static const int NO_VALUE = -1;
+
+// Number of records that are read or written at once.
+static const int IO_BUFFER_RECORDS = 4096;
+
+
+/*
+  File of fixed-size records on disk. Records are appended through a
+  buffer and read sequentially with RecordReader. The file is deleted
+  when the object is destroyed.
+
+  The file is only opened while data is written or read, since a search
+  may create more files than a process can keep open at the same time.
+*/
+class RecordFile {
+    const string path;
+    const int record_size;
+    vector<PackedStateBin> write_buffer;
+    int64_t num_records;
+
+public:
+    RecordFile(const string &path, int record_size)
+        : path(path),
+          record_size(record_size),
+          num_records(0) {
+        ofstream stream(path, ios::trunc | ios::binary);
+        if (!stream) {
+            cerr << "Could not create file " << path << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+
+    ~RecordFile() {
+        remove(path.c_str());
+    }
+
+    RecordFile(const RecordFile &) = delete;
+    RecordFile &operator=(const RecordFile &) = delete;
+
+    void append(const PackedStateBin *record) {
+        write_buffer.insert(write_buffer.end(), record, record + record_size);
+        ++num_records;
+        if (static_cast<int>(write_buffer.size()) ==
+            IO_BUFFER_RECORDS * record_size) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (write_buffer.empty()) {
+            return;
+        }
+        ofstream stream(path, ios::app | ios::binary);
+        stream.write(reinterpret_cast<const char *>(write_buffer.data()),
+                     write_buffer.size() * sizeof(PackedStateBin));
+        if (!stream) {
+            cerr << "Could not write to file " << path << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        vector<PackedStateBin>().swap(write_buffer);
+    }
+
+    /*
+      Replace the content of buffer with up to max_records records,
+      starting at the given record. All records must have been flushed.
+    */
+    void read(int64_t first_record, int max_records,
+              vector<PackedStateBin> &buffer) const {
+        assert(write_buffer.empty());
+        int64_t num_read = min<int64_t>(max_records, num_records - first_record);
+        buffer.resize(num_read * record_size);
+        if (num_read == 0) {
+            return;
+        }
+        ifstream stream(path, ios::binary);
+        stream.seekg(first_record * record_size * sizeof(PackedStateBin));
+        stream.read(reinterpret_cast<char *>(buffer.data()),
+                    buffer.size() * sizeof(PackedStateBin));
+        if (!stream) {
+            cerr << "Could not read from file " << path << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+
+    int64_t get_num_records() const {
+        return num_records;
+    }
+
+    int64_t get_size_in_bytes() const {
+        return num_records * record_size * sizeof(PackedStateBin);
+    }
+};
+
+
+class RecordReader {
+    const RecordFile &file;
+    const int record_size;
+    vector<PackedStateBin> buffer;
+    int64_t next_record;
+    size_t pos;
+
+    void fill_buffer() {
+        file.read(next_record, IO_BUFFER_RECORDS, buffer);
+        next_record += buffer.size() / record_size;
+        pos = 0;
+    }
+public:
+    RecordReader(const RecordFile &file, int record_size)
+        : file(file),
+          record_size(record_size),
+          next_record(0),
+          pos(0) {
+        fill_buffer();
+    }
+
+    // Return the current record or nullptr if all records have been read.
+    const PackedStateBin *get() const {
+        return pos < buffer.size() ? &buffer[pos] : nullptr;
+    }
+
+    void advance() {
+        assert(get());
+        pos += record_size;
+        if (pos == buffer.size()) {
+            fill_buffer();
+        }
+    }
+};
+
+
+static int compare_states(
+    const PackedStateBin *state1, const PackedStateBin *state2,
+    int bins_per_state) {
+    for (int i = 0; i < bins_per_state; ++i) {
+        if (state1[i] != state2[i]) {
+            return state1[i] < state2[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+
+ExternalAStarSearch::ExternalAStarSearch(const Options &opts)
+    : SearchEngine(opts),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")),
+      directory(opts.get<string>("directory")),
+      max_buffered_states(opts.get<int>("max_buffered_states")),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      axiom_evaluator(task_proxy),
+      bins_per_state(state_registry.get_bins_per_state()),
+      record_size(bins_per_state + NUM_RECORD_FIELDS),
+      num_buffered_states(0),
+      num_created_files(0),
+      num_bytes_written(0) {
+    set<Evaluator *> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "external_astar does not support path-dependent evaluators"
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+}
+
+ExternalAStarSearch::~ExternalAStarSearch() {
+}
+
+unique_ptr<RecordFile> ExternalAStarSearch::create_file() {
+    string path = directory + "/external_astar-" +
+        to_string(utils::get_process_id()) + "-" +
+        to_string(num_created_files++) + ".bin";
+    return utils::make_unique_ptr<RecordFile>(path, record_size);
+}
+
+void ExternalAStarSearch::insert(
+    const PackedStateBin *state, int g, int h, int real_g,
+    OperatorID creating_operator, int layer) {
+    vector<PackedStateBin> &buffer = buckets[h][g].buffer;
+    buffer.insert(buffer.end(), state, state + bins_per_state);
+    buffer.push_back(creating_operator.get_index());
+    buffer.push_back(layer);
+    buffer.push_back(real_g);
+    open_buckets.emplace(g + h, g, h);
+    if (++num_buffered_states > max_buffered_states) {
+        spill_buffers();
+    }
+}
+
+void ExternalAStarSearch::spill_buffers() {
+    for (auto &h_and_buckets : buckets) {
+        for (auto &g_and_bucket : h_and_buckets.second) {
+            Bucket &bucket = g_and_bucket.second;
+            if (!bucket.buffer.empty()) {
+                bucket.runs.push_back(create_file());
+                sort_and_write(bucket.buffer, *bucket.runs.back());
+            }
+        }
+    }
+    assert(num_buffered_states == 0);
+}
+
+void ExternalAStarSearch::sort_and_write(
+    vector<PackedStateBin> &records, RecordFile &file) {
+    int num_records = records.size() / record_size;
+    vector<int> order(num_records);
+    iota(order.begin(), order.end(), 0);
+    // Among duplicates, the record with the lowest real g value comes first.
+    sort(order.begin(), order.end(),
+         [&](int i, int j) {
+             const PackedStateBin *record1 = &records[i * record_size];
+             const PackedStateBin *record2 = &records[j * record_size];
+             int cmp = compare_states(record1, record2, bins_per_state);
+             if (cmp != 0) {
+                 return cmp < 0;
+             }
+             return record1[bins_per_state + REAL_G] <
+                    record2[bins_per_state + REAL_G];
+         });
+    for (int i : order) {
+        file.append(&records[i * record_size]);
+    }
+    file.flush();
+    num_bytes_written += file.get_size_in_bytes();
+    num_buffered_states -= num_records;
+    vector<PackedStateBin>().swap(records);
+}
+
+int ExternalAStarSearch::remove_duplicates(int g, int h) {
+    map<int, Bucket> &h_buckets = buckets[h];
+    Bucket &bucket = h_buckets[g];
+    if (!bucket.buffer.empty()) {
+        bucket.runs.push_back(create_file());
+        sort_and_write(bucket.buffer, *bucket.runs.back());
+    }
+
+    vector<RecordReader> runs;
+    for (const unique_ptr<RecordFile> &run : bucket.runs) {
+        runs.emplace_back(*run, record_size);
+    }
+    // All states with the same h value and a lower or equal g value.
+    vector<RecordReader> closed;
+    for (const auto &g_and_bucket : h_buckets) {
+        if (g_and_bucket.first > g) {
+            break;
+        }
+        for (int layer : g_and_bucket.second.layers) {
+            closed.emplace_back(*layers[layer], record_size);
+        }
+    }
+
+    unique_ptr<RecordFile> layer_file = create_file();
+    while (true) {
+        const PackedStateBin *min_record = nullptr;
+        for (const RecordReader &run : runs) {
+            const PackedStateBin *record = run.get();
+            if (record && (!min_record ||
+                           compare_states(record, min_record, bins_per_state) < 0 ||
+                           (compare_states(record, min_record, bins_per_state) == 0 &&
+                            record[bins_per_state + REAL_G] <
+                            min_record[bins_per_state + REAL_G]))) {
+                min_record = record;
+            }
+        }
+        if (!min_record) {
+            break;
+        }
+
+        bool is_duplicate = false;
+        for (RecordReader &reader : closed) {
+            while (reader.get() &&
+                   compare_states(reader.get(), min_record, bins_per_state) < 0) {
+                reader.advance();
+            }
+            if (reader.get() &&
+                compare_states(reader.get(), min_record, bins_per_state) == 0) {
+                is_duplicate = true;
+                break;
+            }
+        }
+        if (!is_duplicate) {
+            layer_file->append(min_record);
+        }
+
+        // Skip all copies of the state. The minimum record is skipped last.
+        vector<PackedStateBin> state(min_record, min_record + bins_per_state);
+        for (RecordReader &run : runs) {
+            while (run.get() &&
+                   compare_states(run.get(), state.data(), bins_per_state) == 0) {
+                run.advance();
+            }
+        }
+    }
+    runs.clear();
+    bucket.runs.clear();
+
+    if (layer_file->get_num_records() == 0) {
+        return NO_VALUE;
+    }
+    layer_file->flush();
+    num_bytes_written += layer_file->get_size_in_bytes();
+    int layer = layers.size();
+    layers.push_back(move(layer_file));
+    bucket.layers.push_back(layer);
+    return layer;
+}
+
+bool ExternalAStarSearch::is_goal(const PackedStateBin *state) const {
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair fact = goal.get_pair();
+        if (state_packer.get(state, fact.var) != fact.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ExternalAStarSearch::is_applicable(
+    const PackedStateBin *state, const OperatorProxy &op) const {
+    for (FactProxy precondition : op.get_preconditions()) {
+        FactPair fact = precondition.get_pair();
+        if (state_packer.get(state, fact.var) != fact.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ExternalAStarSearch::generate_successor(
+    const PackedStateBin *state, const OperatorProxy &op,
+    PackedStateBin *successor) {
+    copy(state, state + bins_per_state, successor);
+    for (EffectProxy effect : op.get_effects()) {
+        bool fires = true;
+        for (FactProxy condition : effect.get_conditions()) {
+            FactPair fact = condition.get_pair();
+            if (state_packer.get(state, fact.var) != fact.value) {
+                fires = false;
+                break;
+            }
+        }
+        if (fires) {
+            FactPair fact = effect.get_fact().get_pair();
+            state_packer.set(successor, fact.var, fact.value);
+        }
+    }
+    axiom_evaluator.evaluate(successor, state_packer);
+}
+
+bool ExternalAStarSearch::expand_layer(int layer, int g) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> successor(bins_per_state);
+    /*
+      The states of a chunk and their successors are registered in a
+      temporary state registry, which allows evaluating every successor
+      only once per chunk. The registry is replaced once it grows too
+      large.
+    */
+    PerStateInformation<int> h_values(NO_VALUE);
+    unique_ptr<StateRegistry> registry;
+    for (RecordReader reader(*layers[layer], record_size); reader.get();
+         reader.advance()) {
+        const PackedStateBin *record = reader.get();
+        if (is_goal(record)) {
+            utils::g_log << "Solution found!" << endl;
+            Plan plan;
+            trace_path(record, plan);
+            set_plan(plan);
+            return true;
+        }
+        statistics.inc_expanded();
+
+        if (!registry ||
+            static_cast<int>(registry->size()) > max_buffered_states) {
+            registry = utils::make_unique_ptr<StateRegistry>(task_proxy);
+        }
+        GlobalState state = registry->insert_packed_state(record);
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+        int real_g = record[bins_per_state + REAL_G];
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = operators[op_id];
+            if (real_g + op.get_cost() >= bound) {
+                continue;
+            }
+            generate_successor(record, op, successor.data());
+            statistics.inc_generated();
+
+            GlobalState succ_state = registry->insert_packed_state(successor.data());
+            int succ_g = g + get_adjusted_cost(op);
+            int &h = h_values[succ_state];
+            if (h == NO_VALUE) {
+                EvaluationContext eval_context(
+                    succ_state, succ_g, false, &statistics);
+                statistics.inc_evaluated_states();
+                h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+                if (h == EvaluationResult::INFTY) {
+                    statistics.inc_dead_ends();
+                }
+            }
+            if (h != EvaluationResult::INFTY) {
+                insert(successor.data(), succ_g, h, real_g + op.get_cost(),
+                       op_id, layer);
+            }
+        }
+    }
+    return false;
+}
+
+void ExternalAStarSearch::trace_path(
+    const PackedStateBin *goal_record, Plan &plan) {
+    assert(plan.empty());
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<PackedStateBin> record(goal_record, goal_record + record_size);
+    vector<PackedStateBin> successor(bins_per_state);
+    while (static_cast<int>(record[bins_per_state + CREATING_OPERATOR]) != NO_VALUE) {
+        OperatorID op_id(record[bins_per_state + CREATING_OPERATOR]);
+        OperatorProxy op = operators[op_id];
+        int layer = record[bins_per_state + GENERATING_LAYER];
+        int real_g = record[bins_per_state + REAL_G];
+        /*
+          All states of a layer have the same adjusted g value, but with
+          adjusted costs their real g values can differ. A state of the
+          generating layer is a valid predecessor if op maps it to the
+          current state and its real g value plus the cost of op is the
+          real g value of the current state. The state that generated the
+          record always qualifies.
+        */
+        bool found_predecessor = false;
+        for (RecordReader reader(*layers[layer], record_size); reader.get();
+             reader.advance()) {
+            const PackedStateBin *predecessor = reader.get();
+            int predecessor_real_g = predecessor[bins_per_state + REAL_G];
+            if (predecessor_real_g + op.get_cost() == real_g &&
+                is_applicable(predecessor, op)) {
+                generate_successor(predecessor, op, successor.data());
+                if (compare_states(successor.data(), record.data(),
+                                   bins_per_state) == 0) {
+                    record.assign(predecessor, predecessor + record_size);
+                    found_predecessor = true;
+                    break;
+                }
+            }
+        }
+        if (!found_predecessor) {
+            cerr << "Could not reconstruct plan." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        plan.push_back(op_id);
+    }
+    reverse(plan.begin(), plan.end());
+}
+
+void ExternalAStarSearch::initialize() {
+    utils::g_log << "Conducting external A* search, (real) bound = " << bound
+                 << endl;
+    const GlobalState &initial_state = state_registry.get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+    if (h == EvaluationResult::INFTY) {
+        utils::g_log << "Initial state is a dead end." << endl;
+        return;
+    }
+    insert(initial_state.get_packed_buffer(), 0, h, 0,
+           OperatorID::no_operator, NO_VALUE);
+}
+
+SearchStatus ExternalAStarSearch::step() {
+    if (open_buckets.empty()) {
+        utils::g_log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    int f, g, h;
+    tie(f, g, h) = *open_buckets.begin();
+    open_buckets.erase(open_buckets.begin());
+    statistics.report_f_value_progress(f);
+
+    int layer = remove_duplicates(g, h);
+    if (layer != NO_VALUE && expand_layer(layer, g)) {
+        return SOLVED;
+    }
+    return IN_PROGRESS;
+}
+
+void ExternalAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    int64_t num_closed_states = 0;
+    for (const unique_ptr<RecordFile> &layer : layers) {
+        num_closed_states += layer->get_num_records();
+    }
+    utils::g_log << "Number of layers: " << layers.size() << endl;
+    utils::g_log << "Number of states in layers: " << num_closed_states << endl;
+    utils::g_log << "Number of files created: " << num_created_files << endl;
+    utils::g_log << "Bytes written to disk: " << num_bytes_written << endl;
+}
+
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "External A* search",
+        "A* search with delayed duplicate detection that keeps the open and "
+        "closed lists in sorted files on disk instead of in memory. See:\n\n" +
+        utils::format_conference_reference(
+            {"Stefan Edelkamp", "Shahid Jabbar", "Stefan Schroedl"},
+            "External A*",
+            "https://doi.org/10.1007/978-3-540-30221-6_19",
+            "Proceedings of the 27th Annual German Conference on "
+            "Artificial Intelligence (KI 2004)",
+            "226-240",
+            "Springer-Verlag",
+            "2004"));
+    parser.document_note(
+        "Memory usage",
+        "States are written to disk in the packed format of the state "
+        "registry. Memory is only needed for the states of the current "
+        "expansion chunk and for buffered successors, both of which are "
+        "bounded by max_buffered_states, and for a read buffer per file "
+        "that is scanned during duplicate detection.");
+    parser.document_note(
+        "Optimality",
+        "Like A*, the search finds optimal solutions for admissible "
+        "heuristics. States that are reached on a cheaper path after "
+        "their expansion are expanded again.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+    parser.add_option<string>(
+        "directory", "directory for the temporary files", ".");
+    parser.add_option<int>(
+        "max_buffered_states",
+        "maximum number of successor states buffered in memory before "
+        "they are written to disk",
+        "1000000",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.dry_run()) {
+        return nullptr;
+    } else {
+        return make_shared<ExternalAStarSearch>(opts);
+    }
+}
+
+static Plugin<SearchEngine> _plugin("external_astar", _parse);
+}
@@ -0,0 +1,107 @@
+#ifndef SEARCH_ENGINES_EXTERNAL_ASTAR_SEARCH_H
+#define SEARCH_ENGINES_EXTERNAL_ASTAR_SEARCH_H
+
+#include "../axioms.h"
+#include "../search_engine.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Evaluator;
+
+namespace int_packer {
+class IntPacker;
+}
+
+namespace options {
+class Options;
+}
+
+namespace external_astar_search {
+class RecordFile;
+
+/*
+  A bucket holds all search nodes with a given g and h value. States
+  that still have to be checked for duplicates are stored in sorted runs
+  on disk plus an unsorted buffer in memory. Every pass over the bucket
+  writes the new, duplicate-free states to a sorted layer file, which
+  forms part of the closed list from then on.
+*/
+struct Bucket {
+    std::vector<PackedStateBin> buffer;
+    std::vector<std::unique_ptr<RecordFile>> runs;
+    // Indices of the layers (passes) that expanded states of this bucket.
+    std::vector<int> layers;
+};
+
+/*
+  External A* (Edelkamp, Jabbar and Schroedl, KI 2004) with delayed
+  duplicate detection.
+
+  Search nodes are kept on disk as records consisting of the packed
+  state data (see IntPacker) and the information needed for plan
+  reconstruction. Only the states of the current expansion chunk and
+  a bounded number of buffered successors reside in memory.
+
+  Buckets are expanded in the order of increasing f and g values.
+  Since h is a function of the state, a state can only be a duplicate
+  of states with the same h value, so a bucket is freed of duplicates by
+  sorting and merging its successor runs and then subtracting the layer
+  files of all buckets with the same h value and lower or equal g value
+  in a single sequential scan of each file.
+
+  Records do not store their parent states. Instead, they store the
+  index of the layer that generated them, and the plan is reconstructed
+  backwards by searching that layer for a state that the creating
+  operator maps to the current state.
+*/
+class ExternalAStarSearch : public SearchEngine {
+    const std::shared_ptr<Evaluator> evaluator;
+    const std::string directory;
+    const int max_buffered_states;
+
+    const int_packer::IntPacker &state_packer;
+    AxiomEvaluator axiom_evaluator;
+    const int bins_per_state;
+    const int record_size;
+
+    // Buckets are indexed by h value first, so that all closed layers
+    // relevant for the duplicate detection of a bucket are neighbors.
+    std::map<int, std::map<int, Bucket>> buckets;
+    // Buckets with pending states, ordered by (f, g, h).
+    std::set<std::tuple<int, int, int>> open_buckets;
+    std::vector<std::unique_ptr<RecordFile>> layers;
+    int num_buffered_states;
+    int num_created_files;
+    int64_t num_bytes_written;
+
+    std::unique_ptr<RecordFile> create_file();
+    void insert(const PackedStateBin *state, int g, int h, int real_g,
+                OperatorID creating_operator, int layer);
+    void spill_buffers();
+    void sort_and_write(std::vector<PackedStateBin> &records, RecordFile &file);
+    int remove_duplicates(int g, int h);
+    bool expand_layer(int layer, int g);
+    bool is_goal(const PackedStateBin *state) const;
+    bool is_applicable(const PackedStateBin *state, const OperatorProxy &op) const;
+    void generate_successor(const PackedStateBin *state, const OperatorProxy &op,
+                            PackedStateBin *successor);
+    void trace_path(const PackedStateBin *goal_record, Plan &plan);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ExternalAStarSearch(const options::Options &opts);
+    virtual ~ExternalAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
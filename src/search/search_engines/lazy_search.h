@@ -42,6 +42,9 @@ protected:
 
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override {
+        return open_list->get_num_entries();
+    }
 
     void generate_successors();
     SearchStatus fetch_next_state();
@@ -0,0 +1,763 @@
+#include "parallel_astar_search.h"
+
+#include "search_common.h"
+
+#include "../axioms.h"
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+
+#include "../algorithms/mpsc_queue.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace parallel_astar_search {
+// Number of successor states that are sent to another worker at once.
+static const int MESSAGE_BATCH_SIZE = 128;
+/*
+  Number of expansions after which all pending messages are sent, even
+  if the batches are not full. This bounds the time that other workers
+  wait for work that has already been generated.
+*/
+static const int FLUSH_INTERVAL = 64;
+
+/*
+  The hash used for distributing states must be independent of the hash
+  used inside the state registries. Otherwise, all states of a worker
+  would share the lowest bits of their hashes and collide in the
+  registry's hash table.
+*/
+static const int DISTRIBUTION_HASH_SALT = 0x5eed;
+
+
+struct NodeInfo {
+    enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
+
+    unsigned int status : 2;
+    int g : 30;
+    int real_g;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+    // Index of the worker that owns the parent state.
+    int parent_worker;
+
+    NodeInfo()
+        : status(NEW), g(-1), real_g(-1), parent_state_id(StateID::no_state),
+          creating_operator(OperatorID::no_operator), parent_worker(-1) {
+    }
+};
+
+
+struct SuccessorMessage {
+    StateID parent_state_id;
+    OperatorID creating_operator;
+    int g;
+    int real_g;
+
+    SuccessorMessage(StateID parent_state_id, OperatorID creating_operator,
+                     int g, int real_g)
+        : parent_state_id(parent_state_id),
+          creating_operator(creating_operator),
+          g(g),
+          real_g(real_g) {
+    }
+};
+
+
+/*
+  Successors that one worker sends to another. The packed data of the
+  i-th state is stored at state_data[i * bins_per_state].
+*/
+struct MessageBatch {
+    int sender;
+    vector<PackedStateBin> state_data;
+    vector<SuccessorMessage> messages;
+
+    explicit MessageBatch(int sender)
+        : sender(sender) {
+    }
+
+    bool empty() const {
+        return messages.empty();
+    }
+};
+
+
+/*
+  Data shared by all workers.
+
+  Termination is detected with a single counter of "work tokens": every
+  worker that is not idle holds one token and every message batch that
+  has been sent but not processed yet holds one token. A worker acquires
+  a token for a batch before sending it and releases it after processing
+  it, and an idle worker acquires its own token before processing a
+  received batch. Hence, the counter only reaches zero once there is no
+  work left anywhere, and it never increases again afterwards.
+
+  The main thread sleeps until a worker signals termination through a
+  condition variable or the time limit is reached.
+*/
+class SharedSearchState {
+    vector<unique_ptr<mpsc_queue::MPSCQueue<MessageBatch>>> inboxes;
+    atomic<int> num_work_tokens;
+    atomic<bool> terminated;
+    mutex termination_mutex;
+    condition_variable termination_condition;
+
+    mutex solution_mutex;
+    atomic<int> incumbent_cost;
+    int goal_worker;
+    StateID goal_state_id;
+public:
+    explicit SharedSearchState(int num_workers)
+        : num_work_tokens(num_workers),
+          terminated(false),
+          incumbent_cost(numeric_limits<int>::max()),
+          goal_worker(-1),
+          goal_state_id(StateID::no_state) {
+        for (int i = 0; i < num_workers; ++i) {
+            inboxes.push_back(
+                utils::make_unique_ptr<mpsc_queue::MPSCQueue<MessageBatch>>());
+        }
+    }
+
+    mpsc_queue::MPSCQueue<MessageBatch> &get_inbox(int worker) {
+        return *inboxes[worker];
+    }
+
+    void acquire_work_token() {
+        ++num_work_tokens;
+    }
+
+    void release_work_token() {
+        if (num_work_tokens.fetch_sub(1) == 1) {
+            terminate();
+        }
+    }
+
+    void terminate() {
+        {
+            lock_guard<mutex> lock(termination_mutex);
+            terminated = true;
+        }
+        termination_condition.notify_all();
+    }
+
+    // Return true if the search terminated within the given time.
+    bool wait_for_termination(double max_seconds) {
+        unique_lock<mutex> lock(termination_mutex);
+        auto is_terminated = [this]() {return terminated.load();};
+        if (max_seconds == numeric_limits<double>::infinity()) {
+            termination_condition.wait(lock, is_terminated);
+            return true;
+        }
+        return termination_condition.wait_for(
+            lock, chrono::duration<double>(max(max_seconds, 0.0)),
+            is_terminated);
+    }
+
+    bool is_terminated() const {
+        return terminated;
+    }
+
+    int get_incumbent_cost() const {
+        return incumbent_cost.load(memory_order_relaxed);
+    }
+
+    void report_solution(int worker, StateID state_id, int cost) {
+        lock_guard<mutex> lock(solution_mutex);
+        if (cost < incumbent_cost) {
+            incumbent_cost = cost;
+            goal_worker = worker;
+            goal_state_id = state_id;
+        }
+    }
+
+    bool found_solution() const {
+        return goal_worker != -1;
+    }
+
+    int get_goal_worker() const {
+        return goal_worker;
+    }
+
+    StateID get_goal_state_id() const {
+        return goal_state_id;
+    }
+};
+
+
+class Worker {
+    const int id;
+    const int num_workers;
+    SharedSearchState &shared_state;
+
+    TaskProxy task_proxy;
+    const int_packer::IntPacker &state_packer;
+    /*
+      AxiomEvaluator keeps scratch data between calls to evaluate(), so
+      every worker needs its own copy.
+    */
+    AxiomEvaluator axiom_evaluator;
+    const successor_generator::SuccessorGenerator &successor_generator;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+    const int bound;
+
+    StateRegistry state_registry;
+    PerStateInformation<NodeInfo> node_infos;
+    shared_ptr<Evaluator> f_evaluator;
+    unique_ptr<StateOpenList> open_list;
+    SearchStatistics statistics;
+
+    mpsc_queue::MPSCQueue<MessageBatch> &inbox;
+    vector<MessageBatch> outbox;
+    vector<MessageBatch> received_batches;
+    vector<PackedStateBin> successor_buffer;
+    vector<OperatorID> applicable_ops;
+
+    int num_sent_states;
+    int num_received_states;
+
+    void send(int receiver, const PackedStateBin *buffer,
+              const SuccessorMessage &message);
+    void flush(int receiver);
+    void flush_all();
+    bool receive();
+    bool expand_next_node();
+public:
+    Worker(int id, int num_workers, SharedSearchState &shared_state,
+           const shared_ptr<AbstractTask> &task,
+           const successor_generator::SuccessorGenerator &successor_generator,
+           const shared_ptr<Evaluator> &h_evaluator,
+           OperatorCost cost_type, bool is_unit_cost, int bound);
+
+    /*
+      Insert the state given by its packed data into this worker's
+      search space unless it is already known with a lower or equal g
+      value. The state must be owned by this worker.
+    */
+    void handle_state(const PackedStateBin *buffer, int parent_worker,
+                      StateID parent_state_id, OperatorID creating_operator,
+                      int g, int real_g);
+
+    /*
+      Evaluate and open the initial state. Must be called before any
+      worker is started and only for the worker owning the initial state.
+      Returns false if the initial state is a dead end.
+    */
+    bool open_initial_state(const GlobalState &initial_state);
+
+    void run();
+
+    StateRegistry &get_state_registry() {
+        return state_registry;
+    }
+
+    int get_num_registered_states() const {
+        return state_registry.size();
+    }
+
+    const NodeInfo &get_node_info(StateID state_id) const {
+        return node_infos[state_registry.lookup_state(state_id)];
+    }
+
+    const SearchStatistics &get_statistics() const {
+        return statistics;
+    }
+
+    int get_num_sent_states() const {
+        return num_sent_states;
+    }
+
+    int get_num_received_states() const {
+        return num_received_states;
+    }
+};
+
+
+static int get_owner(const PackedStateBin *buffer, int bins_per_state,
+                     int num_workers) {
+    utils::HashState hash_state;
+    hash_state.feed(DISTRIBUTION_HASH_SALT);
+    for (int i = 0; i < bins_per_state; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    return hash_state.get_hash32() % num_workers;
+}
+
+
+Worker::Worker(int id, int num_workers, SharedSearchState &shared_state,
+               const shared_ptr<AbstractTask> &task,
+               const successor_generator::SuccessorGenerator &successor_generator,
+               const shared_ptr<Evaluator> &h_evaluator,
+               OperatorCost cost_type, bool is_unit_cost, int bound)
+    : id(id),
+      num_workers(num_workers),
+      shared_state(shared_state),
+      task_proxy(*task),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      axiom_evaluator(task_proxy),
+      successor_generator(successor_generator),
+      cost_type(cost_type),
+      is_unit_cost(is_unit_cost),
+      bound(bound),
+      state_registry(task_proxy),
+      statistics(utils::Verbosity::SILENT),
+      inbox(shared_state.get_inbox(id)),
+      num_sent_states(0),
+      num_received_states(0) {
+    Options opts;
+    opts.set("eval", h_evaluator);
+    auto open_list_factory_and_f_eval =
+        search_common::create_astar_open_list_factory_and_f_eval(opts);
+    open_list = open_list_factory_and_f_eval.first->create_state_open_list();
+    f_evaluator = open_list_factory_and_f_eval.second;
+
+    set<Evaluator *> path_dependent_evaluators;
+    open_list->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "parallel_astar does not support path-dependent evaluators"
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    outbox.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+        outbox.emplace_back(id);
+    }
+    successor_buffer.resize(state_registry.get_bins_per_state());
+}
+
+bool Worker::open_initial_state(const GlobalState &initial_state) {
+    NodeInfo &info = node_infos[initial_state];
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+    if (open_list->is_dead_end(eval_context)) {
+        info.status = NodeInfo::DEAD_END;
+        return false;
+    }
+    info.status = NodeInfo::OPEN;
+    info.g = 0;
+    info.real_g = 0;
+    open_list->insert(eval_context, initial_state.get_id());
+    print_initial_evaluator_values(eval_context);
+    return true;
+}
+
+void Worker::handle_state(
+    const PackedStateBin *buffer, int parent_worker, StateID parent_state_id,
+    OperatorID creating_operator, int g, int real_g) {
+    GlobalState state = state_registry.insert_packed_state(buffer);
+    NodeInfo &info = node_infos[state];
+
+    if (info.status == NodeInfo::DEAD_END) {
+        return;
+    } else if (info.status != NodeInfo::NEW) {
+        if (info.g <= g) {
+            return;
+        }
+        if (info.status == NodeInfo::CLOSED) {
+            statistics.inc_reopened();
+        }
+    }
+
+    EvaluationContext eval_context(state, g, false, &statistics);
+    if (info.status == NodeInfo::NEW) {
+        statistics.inc_evaluated_states();
+        if (open_list->is_dead_end(eval_context)) {
+            info.status = NodeInfo::DEAD_END;
+            statistics.inc_dead_ends();
+            return;
+        }
+    }
+    info.status = NodeInfo::OPEN;
+    info.g = g;
+    info.real_g = real_g;
+    info.parent_state_id = parent_state_id;
+    info.creating_operator = creating_operator;
+    info.parent_worker = parent_worker;
+    open_list->insert(eval_context, state.get_id());
+}
+
+void Worker::send(int receiver, const PackedStateBin *buffer,
+                  const SuccessorMessage &message) {
+    MessageBatch &batch = outbox[receiver];
+    batch.state_data.insert(batch.state_data.end(), buffer,
+                            buffer + state_registry.get_bins_per_state());
+    batch.messages.push_back(message);
+    if (static_cast<int>(batch.messages.size()) >= MESSAGE_BATCH_SIZE) {
+        flush(receiver);
+    }
+}
+
+void Worker::flush(int receiver) {
+    MessageBatch &batch = outbox[receiver];
+    if (batch.empty()) {
+        return;
+    }
+    num_sent_states += batch.messages.size();
+    shared_state.acquire_work_token();
+    MessageBatch outgoing(id);
+    swap(outgoing, batch);
+    shared_state.get_inbox(receiver).push(move(outgoing));
+}
+
+void Worker::flush_all() {
+    for (int receiver = 0; receiver < num_workers; ++receiver) {
+        flush(receiver);
+    }
+}
+
+bool Worker::receive() {
+    if (inbox.empty()) {
+        return false;
+    }
+    received_batches.clear();
+    inbox.pop_all(received_batches);
+    int bins_per_state = state_registry.get_bins_per_state();
+    for (const MessageBatch &batch : received_batches) {
+        int num_messages = batch.messages.size();
+        for (int i = 0; i < num_messages; ++i) {
+            const SuccessorMessage &message = batch.messages[i];
+            handle_state(&batch.state_data[i * bins_per_state], batch.sender,
+                         message.parent_state_id, message.creating_operator,
+                         message.g, message.real_g);
+        }
+        num_received_states += num_messages;
+        shared_state.release_work_token();
+    }
+    received_batches.clear();
+    return true;
+}
+
+bool Worker::expand_next_node() {
+    while (!open_list->empty()) {
+        StateID state_id = open_list->remove_min();
+        GlobalState state = state_registry.lookup_state(state_id);
+        NodeInfo &info = node_infos[state];
+        if (info.status == NodeInfo::CLOSED) {
+            continue;
+        }
+        assert(info.status == NodeInfo::OPEN);
+
+        /*
+          Nodes that cannot lead to a cheaper solution than the incumbent
+          are discarded but stay open: if they are reached again on a
+          cheaper path, they are reinserted into the open list.
+        */
+        EvaluationContext eval_context(state, info.g, false, &statistics);
+        int f = eval_context.get_evaluator_value_or_infinity(f_evaluator.get());
+        if (f >= shared_state.get_incumbent_cost()) {
+            continue;
+        }
+
+        info.status = NodeInfo::CLOSED;
+        statistics.inc_expanded();
+
+        if (task_properties::is_goal_state(task_proxy, state)) {
+            shared_state.report_solution(id, state_id, info.g);
+            return true;
+        }
+
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+        int bins_per_state = state_registry.get_bins_per_state();
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = task_proxy.get_operators()[op_id];
+            if (info.real_g + op.get_cost() >= bound) {
+                continue;
+            }
+            int succ_g = info.g + get_adjusted_action_cost(op, cost_type, is_unit_cost);
+            int succ_real_g = info.real_g + op.get_cost();
+
+            PackedStateBin *buffer = successor_buffer.data();
+            copy(state.get_packed_buffer(),
+                 state.get_packed_buffer() + bins_per_state, buffer);
+            for (EffectProxy effect : op.get_effects()) {
+                if (does_fire(effect, state)) {
+                    FactPair effect_pair = effect.get_fact().get_pair();
+                    state_packer.set(buffer, effect_pair.var, effect_pair.value);
+                }
+            }
+            axiom_evaluator.evaluate(buffer, state_packer);
+            statistics.inc_generated();
+
+            int owner = get_owner(buffer, bins_per_state, num_workers);
+            if (owner == id) {
+                handle_state(buffer, id, state_id, op_id, succ_g, succ_real_g);
+            } else {
+                send(owner, buffer,
+                     SuccessorMessage(state_id, op_id, succ_g, succ_real_g));
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void Worker::run() {
+    int num_expansions_since_flush = 0;
+    while (!shared_state.is_terminated()) {
+        receive();
+        if (expand_next_node()) {
+            if (++num_expansions_since_flush == FLUSH_INTERVAL) {
+                flush_all();
+                num_expansions_since_flush = 0;
+            }
+            continue;
+        }
+
+        // The open list is exhausted: hand out all pending work first.
+        flush_all();
+        num_expansions_since_flush = 0;
+        if (receive()) {
+            continue;
+        }
+
+        shared_state.release_work_token();
+        while (inbox.empty() && !shared_state.is_terminated()) {
+            this_thread::yield();
+        }
+        if (shared_state.is_terminated()) {
+            break;
+        }
+        shared_state.acquire_work_token();
+    }
+}
+
+
+ParallelAStarSearch::ParallelAStarSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts) {
+    int num_threads = opts.get<int>("threads");
+    shared_state = utils::make_unique_ptr<SharedSearchState>(num_threads);
+    /*
+      Evaluators keep per-state data and scratch space, so they must not
+      be shared between threads. We therefore parse the evaluator
+      configuration once per worker.
+    */
+    ParseTree eval_config = opts.get<ParseTree>("eval");
+    for (int i = 0; i < num_threads; ++i) {
+        OptionParser parser(eval_config, registry, predefinitions, false);
+        shared_ptr<Evaluator> h_evaluator =
+            parser.start_parsing<shared_ptr<Evaluator>>();
+        workers.push_back(utils::make_unique_ptr<Worker>(
+                              i, num_threads, *shared_state, task,
+                              successor_generator, h_evaluator,
+                              cost_type, is_unit_cost, bound));
+    }
+}
+
+ParallelAStarSearch::~ParallelAStarSearch() {
+}
+
+void ParallelAStarSearch::initialize() {
+    int num_workers = workers.size();
+    utils::g_log << "Conducting hash-distributed A* search with "
+                 << num_workers << " threads, (real) bound = " << bound
+                 << endl;
+
+    /*
+      The initial state is created in the registry of the search engine
+      and then handed to the worker that owns it.
+    */
+    const GlobalState &initial_state = state_registry.get_initial_state();
+    int bins_per_state = state_registry.get_bins_per_state();
+    int owner = get_owner(initial_state.get_packed_buffer(), bins_per_state,
+                          num_workers);
+    StateRegistry &owner_registry = workers[owner]->get_state_registry();
+    GlobalState owned_initial_state =
+        owner_registry.insert_packed_state(initial_state.get_packed_buffer());
+    if (!workers[owner]->open_initial_state(owned_initial_state)) {
+        utils::g_log << "Initial state is a dead end." << endl;
+    }
+}
+
+SearchStatus ParallelAStarSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    vector<thread> threads;
+    threads.reserve(workers.size());
+    for (const unique_ptr<Worker> &worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+    /*
+      The timer measures the CPU time of all threads, which passes up to
+      num_threads times faster than wall-clock time. We therefore wait for
+      the remaining time divided by the number of threads and check the
+      timer again afterwards.
+    */
+    int num_threads = threads.size();
+    bool timed_out = false;
+    while (!shared_state->wait_for_termination(
+               timer.get_remaining_time() / num_threads)) {
+        if (timer.is_expired()) {
+            timed_out = true;
+            shared_state->terminate();
+        }
+    }
+    for (thread &thread : threads) {
+        thread.join();
+    }
+
+    collect_statistics();
+
+    if (timed_out) {
+        utils::g_log << "Time limit reached. Abort search." << endl;
+    }
+    if (shared_state->found_solution()) {
+        if (timed_out) {
+            // Workers may still have had nodes that lead to cheaper goals.
+            utils::g_log << "Solution found, but it is not proven optimal."
+                         << endl;
+        } else {
+            utils::g_log << "Solution found!" << endl;
+        }
+        Plan plan;
+        trace_path(plan);
+        set_plan(plan);
+        return SOLVED;
+    } else if (timed_out) {
+        return TIMEOUT;
+    }
+    utils::g_log << "Completely explored state space -- no solution!" << endl;
+    return FAILED;
+}
+
+void ParallelAStarSearch::collect_statistics() {
+    for (const unique_ptr<Worker> &worker : workers) {
+        const SearchStatistics &worker_statistics = worker->get_statistics();
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_generated_ops(worker_statistics.get_generated_ops());
+    }
+}
+
+void ParallelAStarSearch::trace_path(Plan &plan) const {
+    assert(plan.empty());
+    int worker = shared_state->get_goal_worker();
+    StateID state_id = shared_state->get_goal_state_id();
+    while (true) {
+        const NodeInfo &info = workers[worker]->get_node_info(state_id);
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_state_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        worker = info.parent_worker;
+        state_id = info.parent_state_id;
+    }
+    reverse(plan.begin(), plan.end());
+}
+
+void ParallelAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    int total_registered_states = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {
+        const Worker &worker = *workers[i];
+        int num_registered_states = worker.get_num_registered_states();
+        total_registered_states += num_registered_states;
+        utils::g_log << "Worker " << i << ": "
+                     << worker.get_statistics().get_expanded() << " expanded, "
+                     << num_registered_states << " registered, "
+                     << worker.get_num_sent_states() << " sent, "
+                     << worker.get_num_received_states() << " received"
+                     << endl;
+    }
+    utils::g_log << "Number of registered states: "
+                 << total_registered_states << endl;
+}
+
+
+static void check_for_predefinitions(
+    OptionParser &parser, const ParseTree &config) {
+    /*
+      Predefined evaluators are shared objects and would be used by all
+      threads at the same time.
+    */
+    for (const options::ParseNode &node : config) {
+        if (parser.get_predefinitions().contains(node.value)) {
+            parser.error(
+                "parallel_astar creates one evaluator per thread and "
+                "therefore does not support predefined evaluators (" +
+                node.value + ")");
+        }
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "Parallel A* search in which every state is owned by one of "
+        "several threads, determined by a hash of the state. Each thread "
+        "runs A* on its own states and sends generated states to their "
+        "owners. See:\n\n" + utils::format_conference_reference(
+            {"Akihiro Kishimoto", "Alex Fukunaga", "Adi Botea"},
+            "Scalable, Parallel Best-First Search for Optimal Sequential "
+            "Planning",
+            "https://www.aaai.org/ocs/index.php/ICAPS/ICAPS09/paper/view/714",
+            "Proceedings of the Nineteenth International Conference on "
+            "Automated Planning and Scheduling (ICAPS 2009)",
+            "201-208",
+            "AAAI Press",
+            "2009"));
+    parser.document_note(
+        "Evaluators",
+        "The evaluator configuration is parsed once per thread, so every "
+        "thread uses its own evaluator objects. Predefined evaluators "
+        "and path-dependent evaluators are not supported.");
+    parser.document_note(
+        "Optimality",
+        "Like A*, the search finds optimal solutions for admissible "
+        "heuristics. Since states are expanded out of the global f-order, "
+        "closed nodes are reopened if a cheaper path to them is found.");
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "threads", "number of worker threads", "1", Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    }
+
+    const ParseTree &eval_config = opts.get<ParseTree>("eval");
+    check_for_predefinitions(parser, eval_config);
+    if (parser.dry_run()) {
+        OptionParser test_parser(eval_config, parser.get_registry(),
+                                 parser.get_predefinitions(), true);
+        test_parser.start_parsing<shared_ptr<Evaluator>>();
+        return nullptr;
+    } else {
+        return make_shared<ParallelAStarSearch>(
+            opts, parser.get_registry(), parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("parallel_astar", _parse);
+}
@@ -0,0 +1,55 @@
+#ifndef SEARCH_ENGINES_PARALLEL_ASTAR_SEARCH_H
+#define SEARCH_ENGINES_PARALLEL_ASTAR_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include <memory>
+#include <vector>
+
+namespace options {
+class Options;
+class Predefinitions;
+class Registry;
+}
+
+namespace parallel_astar_search {
+class SharedSearchState;
+class Worker;
+
+/*
+  Hash-distributed A* (HDA*, Kishimoto, Fukunaga and Botea, ICAPS 2009).
+
+  Every state is owned by exactly one worker thread, determined by a
+  hash of its packed state data. Each worker has its own state
+  registry, search node information, evaluators and open list, and
+  only ever touches states it owns. Successors owned by another worker
+  are sent to that worker in batches over a lock-free message queue.
+
+  Since workers expand nodes out of the global f-order, a solution is
+  only reported as optimal once all workers have run out of nodes with
+  an f value below the cost of the best solution found so far. Nodes
+  reached again on a cheaper path are reopened.
+*/
+class ParallelAStarSearch : public SearchEngine {
+    std::unique_ptr<SharedSearchState> shared_state;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    void collect_statistics();
+    void trace_path(Plan &plan) const;
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    ParallelAStarSearch(const options::Options &opts,
+                        options::Registry &registry,
+                        const options::Predefinitions &predefinitions);
+    virtual ~ParallelAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -1,10 +1,25 @@
 #include "search_node_info.h"
 
-static const int pointer_bytes = sizeof(void *);
-static const int info_bytes = 3 * sizeof(int) + sizeof(StateID);
-static const int padding_bytes = info_bytes % pointer_bytes;
+using namespace std;
 
-static_assert(
-    sizeof(SearchNodeInfo) == info_bytes + padding_bytes,
-    "The size of SearchNodeInfo is larger than expected. This probably means "
-    "that packing two fields into one integer using bitfields is not supported.");
+SearchNodeInfoLayout::SearchNodeInfoLayout(bool store_parents, bool store_real_g)
+    : parent_state_pos(-1),
+      creating_operator_pos(-1),
+      real_g_pos(-1),
+      num_ints(STATUS_AND_G + 1) {
+    if (store_parents) {
+        parent_state_pos = num_ints++;
+        creating_operator_pos = num_ints++;
+    }
+    if (store_real_g) {
+        real_g_pos = num_ints++;
+    }
+}
+
+vector<int> SearchNodeInfoLayout::get_default_info() const {
+    vector<int> info(num_ints, -1);
+    info[STATUS_AND_G] = 0;
+    set_status(info, NEW);
+    set_g(info, -1);
+    return info;
+}
@@ -4,21 +4,117 @@
 #include "operator_id.h"
 #include "state_id.h"
 
+#include <cassert>
+#include <vector>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
-struct SearchNodeInfo {
+/*
+  The search information of each state is stored as a short array of ints
+  (see SearchSpace). Which fields the array contains depends on what the
+  search needs:
+
+  - The node status (2 bits) and the g value (30 bits) share the first int.
+    They are always stored.
+  - The parent state and the creating operator are only stored if the
+    search traces plans back along parent pointers. Without them, plans
+    are reconstructed by regression (see SearchSpace::trace_path).
+  - The real g value (using the original operator costs) is only stored
+    if the search uses adjusted costs. Otherwise, it equals the g value.
+
+  A node therefore needs 16 bytes with all fields, 12 bytes without the
+  real g value and 4 bytes without parent pointers and real g value.
+
+  SearchNodeInfoLayout computes the positions of the fields and encodes
+  and decodes them. Info is an ArrayView<int> or ConstArrayView<int>.
+*/
+class SearchNodeInfoLayout {
+    static const int STATUS_BITS = 2;
+    static const int STATUS_MASK = (1 << STATUS_BITS) - 1;
+
+    static const int STATUS_AND_G = 0;
+    // Positions of the optional fields, or -1 if they are not stored.
+    int parent_state_pos;
+    int creating_operator_pos;
+    int real_g_pos;
+    int num_ints;
+
+public:
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
-    unsigned int status : 2;
-    int g : 30;
-    StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
+    SearchNodeInfoLayout(bool store_parents, bool store_real_g);
+
+    // Return the info of a new node.
+    std::vector<int> get_default_info() const;
+
+    bool stores_parents() const {
+        return parent_state_pos != -1;
+    }
+
+    bool stores_real_g() const {
+        return real_g_pos != -1;
+    }
+
+    int get_num_ints() const {
+        return num_ints;
+    }
+
+    template<typename Info>
+    NodeStatus get_status(const Info &info) const {
+        return static_cast<NodeStatus>(info[STATUS_AND_G] & STATUS_MASK);
+    }
+
+    // The g value of new nodes is -1. We store g + 1 to keep the int positive.
+    template<typename Info>
+    int get_g(const Info &info) const {
+        return (info[STATUS_AND_G] >> STATUS_BITS) - 1;
+    }
+
+    template<typename Info>
+    int get_real_g(const Info &info) const {
+        return stores_real_g() ? info[real_g_pos] : get_g(info);
+    }
+
+    template<typename Info>
+    StateID get_parent_state_id(const Info &info) const {
+        return stores_parents() ? StateID(info[parent_state_pos]) : StateID::no_state;
+    }
+
+    template<typename Info>
+    OperatorID get_creating_operator(const Info &info) const {
+        return stores_parents() ? OperatorID(info[creating_operator_pos])
+               : OperatorID::no_operator;
+    }
+
+    template<typename Info>
+    void set_status(Info &info, NodeStatus status) const {
+        info[STATUS_AND_G] = (info[STATUS_AND_G] & ~STATUS_MASK) | status;
+    }
+
+    template<typename Info>
+    void set_g(Info &info, int g) const {
+        assert(g >= -1 && g < (1 << (31 - STATUS_BITS)) - 1);
+        info[STATUS_AND_G] = ((g + 1) << STATUS_BITS) |
+            (info[STATUS_AND_G] & STATUS_MASK);
+    }
+
+    template<typename Info>
+    void set_real_g(Info &info, int real_g) const {
+        if (stores_real_g()) {
+            info[real_g_pos] = real_g;
+        } else {
+            assert(real_g == get_g(info));
+        }
+    }
 
-    SearchNodeInfo()
-        : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+    template<typename Info>
+    void set_parent(Info &info, StateID parent_state_id,
+                    OperatorID creating_operator) const {
+        if (stores_parents()) {
+            info[parent_state_pos] = parent_state_id.value;
+            info[creating_operator_pos] = creating_operator.get_index();
+        }
     }
 };
 
@@ -1,19 +1,27 @@
 #include "search_space.h"
 
+#include "axioms.h"
 #include "global_state.h"
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "task_utils/task_properties.h"
+#include "utils/collections.h"
+#include "utils/hash.h"
 #include "utils/logging.h"
+#include "utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
 
 SearchNode::SearchNode(const StateRegistry &state_registry,
+                       const SearchNodeInfoLayout &layout,
                        StateID state_id,
-                       SearchNodeInfo &info)
+                       ArrayView<int> info)
     : state_registry(state_registry),
+      layout(layout),
       state_id(state_id),
       info(info) {
     assert(state_id != StateID::no_state);
@@ -24,121 +32,362 @@ GlobalState SearchNode::get_state() const {
 }
 
 bool SearchNode::is_open() const {
-    return info.status == SearchNodeInfo::OPEN;
+    return layout.get_status(info) == SearchNodeInfoLayout::OPEN;
 }
 
 bool SearchNode::is_closed() const {
-    return info.status == SearchNodeInfo::CLOSED;
+    return layout.get_status(info) == SearchNodeInfoLayout::CLOSED;
 }
 
 bool SearchNode::is_dead_end() const {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return layout.get_status(info) == SearchNodeInfoLayout::DEAD_END;
 }
 
 bool SearchNode::is_new() const {
-    return info.status == SearchNodeInfo::NEW;
+    return layout.get_status(info) == SearchNodeInfoLayout::NEW;
 }
 
 int SearchNode::get_g() const {
-    assert(info.g >= 0);
-    return info.g;
+    assert(layout.get_g(info) >= 0);
+    return layout.get_g(info);
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return layout.get_real_g(info);
 }
 
 void SearchNode::open_initial() {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    assert(is_new());
+    layout.set_status(info, SearchNodeInfoLayout::OPEN);
+    layout.set_g(info, 0);
+    layout.set_real_g(info, 0);
+    layout.set_parent(info, StateID::no_state, OperatorID::no_operator);
 }
 
 void SearchNode::open(const SearchNode &parent_node,
                       const OperatorProxy &parent_op,
                       int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    assert(is_new());
+    layout.set_status(info, SearchNodeInfoLayout::OPEN);
+    update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
                         const OperatorProxy &parent_op,
                         int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN ||
-           info.status == SearchNodeInfo::CLOSED);
+    assert(is_open() || is_closed());
 
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    layout.set_status(info, SearchNodeInfoLayout::OPEN);
+    update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
 void SearchNode::update_parent(const SearchNode &parent_node,
                                const OperatorProxy &parent_op,
                                int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN ||
-           info.status == SearchNodeInfo::CLOSED);
+    assert(is_open() || is_closed());
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    layout.set_g(info, parent_node.get_g() + adjusted_cost);
+    layout.set_real_g(info, parent_node.get_real_g() + parent_op.get_cost());
+    layout.set_parent(info, parent_node.get_state_id(),
+                      OperatorID(parent_op.get_id()));
 }
 
 void SearchNode::close() {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(is_open());
+    layout.set_status(info, SearchNodeInfoLayout::CLOSED);
 }
 
 void SearchNode::mark_as_dead_end() {
-    info.status = SearchNodeInfo::DEAD_END;
+    layout.set_status(info, SearchNodeInfoLayout::DEAD_END);
 }
 
 void SearchNode::dump(const TaskProxy &task_proxy) const {
     utils::g_log << state_id << ": ";
     get_state().dump_fdr();
-    if (info.creating_operator != OperatorID::no_operator) {
+    OperatorID creating_operator = layout.get_creating_operator(info);
+    if (creating_operator != OperatorID::no_operator) {
         OperatorsProxy operators = task_proxy.get_operators();
-        OperatorProxy op = operators[info.creating_operator.get_index()];
+        OperatorProxy op = operators[creating_operator.get_index()];
         utils::g_log << " created by " << op.get_name()
-                     << " from " << info.parent_state_id << endl;
+                     << " from " << layout.get_parent_state_id(info) << endl;
+    } else if (!layout.stores_parents()) {
+        utils::g_log << " parent not stored" << endl;
     } else {
         utils::g_log << " no parent" << endl;
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                         bool store_parents)
+    : cost_type(cost_type),
+      is_unit_cost(task_properties::is_unit_cost(state_registry.get_task_proxy())),
+      layout(store_parents, cost_type != OperatorCost::NORMAL),
+      search_node_infos(layout.get_default_info()),
+      state_registry(state_registry) {
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
-    return SearchNode(state_registry, state.get_id(), search_node_infos[state]);
+    return SearchNode(
+        state_registry, layout, state.get_id(), search_node_infos[state]);
+}
+
+static bool is_applicable(
+    const OperatorProxy &op, const PackedStateBin *buffer,
+    const int_packer::IntPacker &state_packer) {
+    for (FactProxy precondition : op.get_preconditions()) {
+        FactPair fact = precondition.get_pair();
+        if (state_packer.get(buffer, fact.var) != fact.value)
+            return false;
+    }
+    return true;
+}
+
+static void apply_operator(
+    const OperatorProxy &op, const PackedStateBin *buffer,
+    PackedStateBin *successor_buffer,
+    const int_packer::IntPacker &state_packer, AxiomEvaluator &axiom_evaluator) {
+    copy(buffer, buffer + state_packer.get_num_bins(), successor_buffer);
+    for (EffectProxy effect : op.get_effects()) {
+        bool fires = true;
+        for (FactProxy condition : effect.get_conditions()) {
+            FactPair fact = condition.get_pair();
+            if (state_packer.get(buffer, fact.var) != fact.value) {
+                fires = false;
+                break;
+            }
+        }
+        if (fires) {
+            FactPair fact = effect.get_fact().get_pair();
+            state_packer.set(successor_buffer, fact.var, fact.value);
+        }
+    }
+    axiom_evaluator.evaluate(successor_buffer, state_packer);
+}
+
+bool SearchSpace::is_reached_within(StateID id, int g) const {
+    ConstArrayView<int> info = search_node_infos[state_registry.lookup_state(id)];
+    SearchNodeInfoLayout::NodeStatus status = layout.get_status(info);
+    return (status == SearchNodeInfoLayout::OPEN ||
+            status == SearchNodeInfoLayout::CLOSED) &&
+           layout.get_g(info) <= g;
+}
+
+void SearchSpace::get_regression_predecessors(
+    const GlobalState &state,
+    vector<pair<StateID, OperatorID>> &predecessors) const {
+    TaskProxy task_proxy = state_registry.get_task_proxy();
+    const int_packer::IntPacker &state_packer =
+        task_properties::g_state_packers[task_proxy];
+    AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[task_proxy];
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_bins = state_packer.get_num_bins();
+    const PackedStateBin *buffer = state.get_packed_buffer();
+    int g = layout.get_g(search_node_infos[state]);
+    size_t num_states = state_registry.size();
+
+    vector<PackedStateBin> predecessor_buffer(num_bins);
+    vector<PackedStateBin> successor_buffer(num_bins);
+    vector<int> precondition_values(variables.size());
+    vector<int> free_vars;
+    vector<int> values;
+    // Operators whose predecessors are found by scanning the registry.
+    vector<pair<OperatorProxy, int>> scanned_ops;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        int cost = get_adjusted_action_cost(op, cost_type, is_unit_cost);
+        if (cost > g)
+            continue;
+
+        /*
+          Variables affected by the operator have the precondition value in
+          the predecessor, or any value if there is no precondition.
+          Conditional effects are only checked when applying the operator.
+        */
+        fill(precondition_values.begin(), precondition_values.end(), -1);
+        for (FactProxy precondition : op.get_preconditions()) {
+            FactPair fact = precondition.get_pair();
+            precondition_values[fact.var] = fact.value;
+        }
+        copy(buffer, buffer + num_bins, predecessor_buffer.begin());
+        free_vars.clear();
+        bool regressable = true;
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair fact = effect.get_fact().get_pair();
+            if (effect.get_conditions().empty() &&
+                state_packer.get(buffer, fact.var) != fact.value) {
+                regressable = false;
+                break;
+            }
+            if (precondition_values[fact.var] != -1) {
+                state_packer.set(predecessor_buffer.data(), fact.var,
+                                 precondition_values[fact.var]);
+            } else if (find(free_vars.begin(), free_vars.end(), fact.var) ==
+                       free_vars.end()) {
+                free_vars.push_back(fact.var);
+            }
+        }
+        if (!regressable)
+            continue;
+
+        /*
+          Only registered states can be predecessors, so if the free
+          variables have more value combinations than there are states, we
+          test the registered states instead of enumerating the combinations.
+        */
+        size_t num_combinations = 1;
+        for (int var : free_vars) {
+            num_combinations *= variables[var].get_domain_size();
+            if (num_combinations > num_states)
+                break;
+        }
+        if (num_combinations > num_states) {
+            scanned_ops.emplace_back(op, cost);
+            continue;
+        }
+
+        // Enumerate all values of the free variables.
+        values.assign(free_vars.size(), 0);
+        while (true) {
+            for (size_t i = 0; i < free_vars.size(); ++i) {
+                state_packer.set(predecessor_buffer.data(), free_vars[i], values[i]);
+            }
+            axiom_evaluator.evaluate(predecessor_buffer.data(), state_packer);
+            if (is_applicable(op, predecessor_buffer.data(), state_packer)) {
+                apply_operator(op, predecessor_buffer.data(),
+                               successor_buffer.data(), state_packer,
+                               axiom_evaluator);
+                if (equal(successor_buffer.begin(), successor_buffer.end(), buffer)) {
+                    StateID id = state_registry.find_state(predecessor_buffer.data());
+                    if (id != StateID::no_state && is_reached_within(id, g - cost)) {
+                        predecessors.emplace_back(id, OperatorID(op.get_id()));
+                    }
+                }
+            }
+
+            // Advance to the next assignment.
+            size_t pos = 0;
+            while (pos < free_vars.size() &&
+                   ++values[pos] == variables[free_vars[pos]].get_domain_size()) {
+                values[pos] = 0;
+                ++pos;
+            }
+            if (pos == free_vars.size())
+                break;
+        }
+    }
+
+    if (!scanned_ops.empty()) {
+        for (StateID id : state_registry) {
+            GlobalState candidate = state_registry.lookup_state(id);
+            const PackedStateBin *candidate_buffer = candidate.get_packed_buffer();
+            for (const pair<OperatorProxy, int> &op_and_cost : scanned_ops) {
+                const OperatorProxy &op = op_and_cost.first;
+                if (!is_applicable(op, candidate_buffer, state_packer) ||
+                    !is_reached_within(id, g - op_and_cost.second))
+                    continue;
+                apply_operator(op, candidate_buffer, successor_buffer.data(),
+                               state_packer, axiom_evaluator);
+                if (equal(successor_buffer.begin(), successor_buffer.end(), buffer)) {
+                    predecessors.emplace_back(id, OperatorID(op.get_id()));
+                }
+            }
+        }
+    }
+}
+
+void SearchSpace::trace_path_by_regression(
+    const GlobalState &goal_state, vector<OperatorID> &path) const {
+    /*
+      We run a depth-first search from the goal, trying the predecessors
+      with the lowest g values first. The closed list prevents cycles
+      with zero-cost operators.
+    */
+    struct Frame {
+        StateID state_id;
+        // Operator leading from this state to the state of the previous frame.
+        OperatorID op_id;
+        vector<pair<StateID, OperatorID>> predecessors;
+        size_t next_predecessor;
+    };
+
+    StateID initial_state_id = state_registry.get_initial_state().get_id();
+    utils::HashSet<StateID> closed;
+    vector<Frame> stack;
+    stack.push_back({goal_state.get_id(), OperatorID::no_operator, {}, 0});
+    closed.insert(goal_state.get_id());
+    bool expand_top = true;
+    while (!stack.empty()) {
+        Frame &top = stack.back();
+        if (top.state_id == initial_state_id)
+            break;
+        if (expand_top) {
+            GlobalState state = state_registry.lookup_state(top.state_id);
+            get_regression_predecessors(state, top.predecessors);
+            auto get_g = [this](StateID id) {
+                    return layout.get_g(
+                        search_node_infos[state_registry.lookup_state(id)]);
+                };
+            /*
+              With adjusted costs, several predecessors can have the same
+              g value but different real g values. We prefer those that
+              are consistent with the real g value of the state, so that
+              the plan cost usually matches the cost found by the search.
+            */
+            int real_g = layout.get_real_g(search_node_infos[state]);
+            OperatorsProxy operators = state_registry.get_task_proxy().get_operators();
+            auto is_inconsistent = [&](const pair<StateID, OperatorID> &predecessor) {
+                    int predecessor_real_g = layout.get_real_g(
+                        search_node_infos[state_registry.lookup_state(predecessor.first)]);
+                    int cost = operators[predecessor.second].get_cost();
+                    return predecessor_real_g + cost != real_g;
+                };
+            sort(top.predecessors.begin(), top.predecessors.end(),
+                 [&](const pair<StateID, OperatorID> &lhs,
+                     const pair<StateID, OperatorID> &rhs) {
+                     return make_pair(is_inconsistent(lhs), get_g(lhs.first)) <
+                            make_pair(is_inconsistent(rhs), get_g(rhs.first));
+                 });
+            expand_top = false;
+        }
+        if (top.next_predecessor == top.predecessors.size()) {
+            stack.pop_back();
+            continue;
+        }
+        pair<StateID, OperatorID> predecessor = top.predecessors[top.next_predecessor++];
+        if (closed.insert(predecessor.first).second) {
+            stack.push_back({predecessor.first, predecessor.second, {}, 0});
+            expand_top = true;
+        }
+    }
+    if (stack.empty()) {
+        cerr << "Could not reconstruct the plan by regression." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    for (size_t i = stack.size() - 1; i > 0; --i) {
+        path.push_back(stack[i].op_id);
+    }
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
                              vector<OperatorID> &path) const {
-    GlobalState current_state = goal_state;
     assert(path.empty());
+    if (!layout.stores_parents()) {
+        trace_path_by_regression(goal_state, path);
+        return;
+    }
+    GlobalState current_state = goal_state;
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        ConstArrayView<int> info = search_node_infos[current_state];
+        OperatorID creating_operator = layout.get_creating_operator(info);
+        if (creating_operator == OperatorID::no_operator) {
+            assert(layout.get_parent_state_id(info) == StateID::no_state);
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        path.push_back(creating_operator);
+        current_state = state_registry.lookup_state(layout.get_parent_state_id(info));
     }
     reverse(path.begin(), path.end());
 }
@@ -149,14 +398,16 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         GlobalState state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
+        ConstArrayView<int> node_info = search_node_infos[state];
+        OperatorID creating_operator = layout.get_creating_operator(node_info);
+        StateID parent_state_id = layout.get_parent_state_id(node_info);
         utils::g_log << id << ": ";
         state.dump_fdr();
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op = operators[node_info.creating_operator.get_index()];
+        if (creating_operator != OperatorID::no_operator &&
+            parent_state_id != StateID::no_state) {
+            OperatorProxy op = operators[creating_operator.get_index()];
             utils::g_log << " created by " << op.get_name()
-                         << " from " << node_info.parent_state_id << endl;
+                         << " from " << parent_state_id << endl;
         } else {
             utils::g_log << "has no parent" << endl;
         }
@@ -165,4 +416,6 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
 
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics();
+    utils::g_log << "Search node size: "
+                 << layout.get_num_ints() * sizeof(int) << " bytes" << endl;
 }
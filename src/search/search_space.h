@@ -3,9 +3,10 @@
 
 #include "global_state.h"
 #include "operator_cost.h"
-#include "per_state_information.h"
+#include "per_state_array.h"
 #include "search_node_info.h"
 
+#include <utility>
 #include <vector>
 
 class GlobalState;
@@ -15,12 +16,14 @@ class TaskProxy;
 
 class SearchNode {
     const StateRegistry &state_registry;
+    const SearchNodeInfoLayout &layout;
     StateID state_id;
-    SearchNodeInfo &info;
+    ArrayView<int> info;
 public:
     SearchNode(const StateRegistry &state_registry,
+               const SearchNodeInfoLayout &layout,
                StateID state_id,
-               SearchNodeInfo &info);
+               ArrayView<int> info);
 
     StateID get_state_id() const {
         return state_id;
@@ -53,13 +56,42 @@ public:
 
 
 class SearchSpace {
-    PerStateInformation<SearchNodeInfo> search_node_infos;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+    const SearchNodeInfoLayout layout;
+    PerStateArray<int> search_node_infos;
 
     StateRegistry &state_registry;
+
+    // True if the state is open or closed with a g value of at most g.
+    bool is_reached_within(StateID id, int g) const;
+    void get_regression_predecessors(
+        const GlobalState &state,
+        std::vector<std::pair<StateID, OperatorID>> &predecessors) const;
+    void trace_path_by_regression(const GlobalState &goal_state,
+                                  std::vector<OperatorID> &path) const;
 public:
-    explicit SearchSpace(StateRegistry &state_registry);
+    /*
+      If store_parents is false, the search space uses less memory per
+      node, but tracing a path requires a search backwards from the goal.
+    */
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                bool store_parents = true);
 
     SearchNode get_node(const GlobalState &state);
+    /*
+      Without parent pointers, the path is reconstructed by regression: we
+      repeatedly look for a reached predecessor state p and an operator o
+      leading from p to the current state with g(p) + cost(o) <= g(current).
+      Since g values only decrease during search, the parent that created
+      the node always qualifies.
+
+      We regress the current state through each operator and look up the
+      predecessor by hash. Variables that the operator changes without a
+      precondition can have any value in the predecessor, so we look up all
+      combinations of their values, or test all registered states if there
+      are more combinations than registered states.
+    */
     void trace_path(const GlobalState &goal_state,
                     std::vector<OperatorID> &path) const;
 
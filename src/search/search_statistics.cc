@@ -25,6 +25,19 @@ SearchStatistics::SearchStatistics(utils::Verbosity verbosity)
     lastjump_generated_states = 0;
 
     lastjump_f_value = -1;
+
+    measure_evaluator_times = false;
+}
+
+void SearchStatistics::add_evaluator_time(const Evaluator *evaluator, double seconds) {
+    // There are only a few evaluators, so a linear scan is fastest.
+    for (auto &entry : evaluator_times) {
+        if (entry.first == evaluator) {
+            entry.second += seconds;
+            return;
+        }
+    }
+    evaluator_times.emplace_back(evaluator, seconds);
 }
 
 void SearchStatistics::report_f_value_progress(int f) {
@@ -6,9 +6,16 @@
 
   It keeps counters for expanded, generated and evaluated states (and
   some other statistics) and provides uniform output for all search
-  methods.
+  methods. The counters use 64 bits because long runs can generate more
+  than 2^31 states.
 */
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Evaluator;
+
 namespace utils {
 enum class Verbosity;
 }
@@ -17,21 +24,29 @@ class SearchStatistics {
     const utils::Verbosity verbosity;
 
     // General statistics
-    int expanded_states;  // no states for which successors were generated
-    int evaluated_states; // no states for which h fn was computed
-    int evaluations;      // no of heuristic evaluations performed
-    int generated_states; // no states created in total (plus those removed since already in close list)
-    int reopened_states;  // no of *closed* states which we reopened
-    int dead_end_states;
+    int64_t expanded_states;  // no states for which successors were generated
+    int64_t evaluated_states; // no states for which h fn was computed
+    int64_t evaluations;      // no of heuristic evaluations performed
+    int64_t generated_states; // no states created in total (plus those removed since already in close list)
+    int64_t reopened_states;  // no of *closed* states which we reopened
+    int64_t dead_end_states;
 
-    int generated_ops;    // no of operators that were returned as applicable
+    int64_t generated_ops;    // no of operators that were returned as applicable
 
     // Statistics related to f values
     int lastjump_f_value; //f value obtained in the last jump
-    int lastjump_expanded_states; // same guy but at point where the last jump in the open list
-    int lastjump_reopened_states; // occurred (jump == f-value of the first node in the queue increases)
-    int lastjump_evaluated_states;
-    int lastjump_generated_states;
+    int64_t lastjump_expanded_states; // same guy but at point where the last jump in the open list
+    int64_t lastjump_reopened_states; // occurred (jump == f-value of the first node in the queue increases)
+    int64_t lastjump_evaluated_states;
+    int64_t lastjump_generated_states;
+
+    /*
+      Time in seconds spent computing the results of each evaluator
+      (including the time of evaluators it uses). Only measured when
+      enabled because it requires reading the clock for every evaluation.
+    */
+    bool measure_evaluator_times;
+    std::vector<std::pair<const Evaluator *, double>> evaluator_times;
 
     void print_f_line() const;
 public:
@@ -39,21 +54,29 @@ public:
     ~SearchStatistics() = default;
 
     // Methods that update statistics.
-    void inc_expanded(int inc = 1) {expanded_states += inc;}
-    void inc_evaluated_states(int inc = 1) {evaluated_states += inc;}
-    void inc_generated(int inc = 1) {generated_states += inc;}
-    void inc_reopened(int inc = 1) {reopened_states += inc;}
-    void inc_generated_ops(int inc = 1) {generated_ops += inc;}
-    void inc_evaluations(int inc = 1) {evaluations += inc;}
-    void inc_dead_ends(int inc = 1) {dead_end_states += inc;}
+    void inc_expanded(int64_t inc = 1) {expanded_states += inc;}
+    void inc_evaluated_states(int64_t inc = 1) {evaluated_states += inc;}
+    void inc_generated(int64_t inc = 1) {generated_states += inc;}
+    void inc_reopened(int64_t inc = 1) {reopened_states += inc;}
+    void inc_generated_ops(int64_t inc = 1) {generated_ops += inc;}
+    void inc_evaluations(int64_t inc = 1) {evaluations += inc;}
+    void inc_dead_ends(int64_t inc = 1) {dead_end_states += inc;}
+
+    void set_measure_evaluator_times(bool measure) {measure_evaluator_times = measure;}
+    bool get_measure_evaluator_times() const {return measure_evaluator_times;}
+    void add_evaluator_time(const Evaluator *evaluator, double seconds);
 
     // Methods that access statistics.
-    int get_expanded() const {return expanded_states;}
-    int get_evaluated_states() const {return evaluated_states;}
-    int get_evaluations() const {return evaluations;}
-    int get_generated() const {return generated_states;}
-    int get_reopened() const {return reopened_states;}
-    int get_generated_ops() const {return generated_ops;}
+    int64_t get_expanded() const {return expanded_states;}
+    int64_t get_evaluated_states() const {return evaluated_states;}
+    int64_t get_evaluations() const {return evaluations;}
+    int64_t get_generated() const {return generated_states;}
+    int64_t get_reopened() const {return reopened_states;}
+    int64_t get_generated_ops() const {return generated_ops;}
+    int64_t get_dead_ends() const {return dead_end_states;}
+    const std::vector<std::pair<const Evaluator *, double>> &get_evaluator_times() const {
+        return evaluator_times;
+    }
 
     /*
       Call the following method with the f value of every expanded
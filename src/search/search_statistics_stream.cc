@@ -0,0 +1,149 @@
+#include "search_statistics_stream.h"
+
+#include "evaluator.h"
+#include "search_statistics.h"
+#include "state_registry.h"
+
+#include "utils/system.h"
+#include "utils/timer.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+static string escape_json(const string &value) {
+    string result;
+    for (char c : value) {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+static string escape_csv(const string &value) {
+    string result = "\"";
+    for (char c : value) {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    return result + "\"";
+}
+
+SearchStatisticsStream::SearchStatisticsStream(
+    StatisticsFormat format, const string &filename, double interval)
+    : format(format),
+      interval(interval),
+      stream(filename),
+      last_report_time(utils::g_timer()),
+      last_expanded(0),
+      last_generated(0),
+      last_evaluations(0),
+      csv_header_written(false) {
+    assert(format != StatisticsFormat::NONE);
+    if (!stream) {
+        cerr << "could not open statistics file " << filename << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+bool SearchStatisticsStream::is_report_due() const {
+    return utils::g_timer() - last_report_time >= interval;
+}
+
+void SearchStatisticsStream::write_csv_header(const SearchStatistics &statistics) {
+    stream << "time,expanded,evaluated,evaluations,generated,reopened,dead_ends,"
+           << "expansions_per_second,generations_per_second,evaluations_per_second,"
+           << "open_list_size,registered_states,registry_memory_bytes,"
+           << "hash_set_load_factor,peak_memory_kb";
+    for (const auto &entry : statistics.get_evaluator_times()) {
+        csv_evaluators.push_back(entry.first);
+        stream << "," << escape_csv("time " + entry.first->get_description());
+    }
+    stream << "\n";
+    csv_header_written = true;
+}
+
+void SearchStatisticsStream::report(
+    const SearchStatistics &statistics, const StateRegistry &state_registry,
+    int open_list_size) {
+    double time = utils::g_timer();
+    double elapsed = time - last_report_time;
+    double expansion_rate = 0;
+    double generation_rate = 0;
+    double evaluation_rate = 0;
+    if (elapsed > 0) {
+        expansion_rate = (statistics.get_expanded() - last_expanded) / elapsed;
+        generation_rate = (statistics.get_generated() - last_generated) / elapsed;
+        evaluation_rate = (statistics.get_evaluations() - last_evaluations) / elapsed;
+    }
+    last_report_time = time;
+    last_expanded = statistics.get_expanded();
+    last_generated = statistics.get_generated();
+    last_evaluations = statistics.get_evaluations();
+
+    if (format == StatisticsFormat::JSON) {
+        stream << "{\"time\": " << time
+               << ", \"expanded\": " << statistics.get_expanded()
+               << ", \"evaluated\": " << statistics.get_evaluated_states()
+               << ", \"evaluations\": " << statistics.get_evaluations()
+               << ", \"generated\": " << statistics.get_generated()
+               << ", \"reopened\": " << statistics.get_reopened()
+               << ", \"dead_ends\": " << statistics.get_dead_ends()
+               << ", \"expansions_per_second\": " << expansion_rate
+               << ", \"generations_per_second\": " << generation_rate
+               << ", \"evaluations_per_second\": " << evaluation_rate
+               << ", \"open_list_size\": ";
+        if (open_list_size == -1)
+            stream << "null";
+        else
+            stream << open_list_size;
+        stream << ", \"registered_states\": " << state_registry.size()
+               << ", \"registry_memory_bytes\": " << state_registry.get_memory_in_bytes()
+               << ", \"hash_set_load_factor\": " << state_registry.get_hash_set_load_factor()
+               << ", \"peak_memory_kb\": " << utils::get_peak_memory_in_kb()
+               << ", \"evaluator_times\": {";
+        bool first = true;
+        for (const auto &entry : statistics.get_evaluator_times()) {
+            if (!first)
+                stream << ", ";
+            first = false;
+            stream << "\"" << escape_json(entry.first->get_description())
+                   << "\": " << entry.second;
+        }
+        stream << "}}\n";
+    } else {
+        assert(format == StatisticsFormat::CSV);
+        if (!csv_header_written)
+            write_csv_header(statistics);
+        stream << time
+               << "," << statistics.get_expanded()
+               << "," << statistics.get_evaluated_states()
+               << "," << statistics.get_evaluations()
+               << "," << statistics.get_generated()
+               << "," << statistics.get_reopened()
+               << "," << statistics.get_dead_ends()
+               << "," << expansion_rate
+               << "," << generation_rate
+               << "," << evaluation_rate
+               << ",";
+        if (open_list_size != -1)
+            stream << open_list_size;
+        stream << "," << state_registry.size()
+               << "," << state_registry.get_memory_in_bytes()
+               << "," << state_registry.get_hash_set_load_factor()
+               << "," << utils::get_peak_memory_in_kb();
+        for (const Evaluator *evaluator : csv_evaluators) {
+            double evaluator_time = 0;
+            for (const auto &entry : statistics.get_evaluator_times()) {
+                if (entry.first == evaluator)
+                    evaluator_time = entry.second;
+            }
+            stream << "," << evaluator_time;
+        }
+        stream << "\n";
+    }
+    stream.flush();
+}
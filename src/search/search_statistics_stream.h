@@ -0,0 +1,64 @@
+#ifndef SEARCH_STATISTICS_STREAM_H
+#define SEARCH_STATISTICS_STREAM_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Evaluator;
+class SearchStatistics;
+class StateRegistry;
+
+enum class StatisticsFormat {
+    NONE,
+    JSON,
+    CSV
+};
+
+/*
+  Periodically writes the search statistics in a machine-readable format
+  to a file, one record per line. With JSON, every line is a JSON object
+  ("JSON lines"). With CSV, the first line is a header. Since evaluators
+  are only known once they have been used, the CSV header contains the
+  time columns of the evaluators that were used before the first record.
+
+  Each record contains the counters of SearchStatistics, the expansion,
+  generation and evaluation rates since the previous record, the number
+  of entries in the open list (if known), the number of registered
+  states, the memory used by the state registry, the load factor of its
+  hash set, the peak memory and the time spent in each evaluator.
+
+  Special files such as /dev/stderr or /dev/fd/3 can be used to write to
+  a file descriptor.
+*/
+class SearchStatisticsStream {
+    const StatisticsFormat format;
+    const double interval;
+    std::ofstream stream;
+
+    double last_report_time;
+    int64_t last_expanded;
+    int64_t last_generated;
+    int64_t last_evaluations;
+    bool csv_header_written;
+    std::vector<const Evaluator *> csv_evaluators;
+
+    void write_csv_header(const SearchStatistics &statistics);
+public:
+    SearchStatisticsStream(
+        StatisticsFormat format, const std::string &filename, double interval);
+
+    // Return true if at least interval seconds passed since the last record.
+    bool is_report_due() const;
+
+    /*
+      Write a record. Pass -1 as open_list_size if the number of open
+      entries is unknown.
+    */
+    void report(const SearchStatistics &statistics,
+                const StateRegistry &state_registry,
+                int open_list_size);
+};
+
+#endif
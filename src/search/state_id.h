@@ -1,6 +1,8 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
+#include "utils/hash.h"
+
 #include <iostream>
 
 // For documentation on classes relevant to storing and working with registered
@@ -8,6 +10,8 @@
 
 class StateID {
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
+    friend class SearchNodeInfoLayout;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
@@ -35,7 +39,17 @@ public:
     bool operator!=(const StateID &other) const {
         return !(*this == other);
     }
+
+    int hash() const {
+        return value;
+    }
 };
 
+namespace utils {
+inline void feed(HashState &hash_state, StateID id) {
+    feed(hash_state, id.hash());
+}
+}
+
 
 #endif
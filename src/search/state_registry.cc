@@ -5,19 +5,40 @@
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/memory.h"
+#include "utils/profiling.h"
+
+#include <algorithm>
 
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(const TaskProxy &task_proxy, bool compress_states)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      tree_compressor(
+          compress_states ?
+          utils::make_unique_ptr<tree_compression::TreeCompressor>(
+              get_bins_per_state()) : nullptr),
+      state_data_pool(get_stored_state_size() + 1),
       registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
-          StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
-      cached_initial_state(0) {
+          StateIDStoredHash(state_data_pool, get_stored_state_size()),
+          StateIDSemanticEqual(state_data_pool, get_stored_state_size() + 1)),
+      cached_initial_state(0),
+      stored_state_buffer(get_stored_state_size() + 1) {
+    for (VariableProxy var : task_proxy.get_variables()) {
+        zobrist_offsets.push_back(zobrist_keys.size());
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            utils::HashState hash_state;
+            hash_state.feed(var.get_id());
+            hash_state.feed(value);
+            zobrist_keys.push_back(hash_state.get_hash32());
+        }
+        if (var.is_derived()) {
+            derived_variables.push_back(var.get_id());
+        }
+    }
 }
 
 
@@ -25,6 +46,75 @@ StateRegistry::~StateRegistry() {
     delete cached_initial_state;
 }
 
+int StateRegistry::get_stored_state_size() const {
+    // A compressed state is represented by the root of its tree.
+    return tree_compressor ? 1 : get_bins_per_state();
+}
+
+int_hash_set::HashType StateRegistry::compute_hash(
+    const PackedStateBin *buffer) const {
+    int_hash_set::HashType hash = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        hash ^= get_zobrist_key(var, state_packer.get(buffer, var));
+    }
+    return hash;
+}
+
+int_hash_set::HashType StateRegistry::generate_successor(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
+    assert(!op.is_axiom());
+    assert(&predecessor.get_registry() == this);
+    const PackedStateBin *predecessor_buffer = predecessor.get_packed_buffer();
+    copy(predecessor_buffer, predecessor_buffer + get_bins_per_state(), buffer);
+    int_hash_set::HashType hash =
+        state_data_pool[predecessor.get_id().value][get_stored_state_size()];
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            int old_value = state_packer.get(buffer, effect_pair.var);
+            if (old_value != effect_pair.value) {
+                hash ^= get_zobrist_key(effect_pair.var, old_value) ^
+                    get_zobrist_key(effect_pair.var, effect_pair.value);
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+    }
+    if (!derived_variables.empty()) {
+        axiom_evaluator.evaluate(buffer, state_packer);
+        for (int var : derived_variables) {
+            int old_value = state_packer.get(predecessor_buffer, var);
+            int new_value = state_packer.get(buffer, var);
+            if (old_value != new_value) {
+                hash ^= get_zobrist_key(var, old_value) ^
+                    get_zobrist_key(var, new_value);
+            }
+        }
+    }
+    assert(hash == compute_hash(buffer));
+    return hash;
+}
+
+void StateRegistry::push_state(
+    const PackedStateBin *buffer, int_hash_set::HashType hash,
+    const GlobalState *predecessor) {
+    int stored_state_size = get_stored_state_size();
+    if (tree_compressor) {
+        if (predecessor) {
+            assert(&predecessor->get_registry() == this);
+            stored_state_buffer[0] = tree_compressor->insert(
+                buffer, predecessor->get_packed_buffer(),
+                state_data_pool[predecessor->get_id().value][0]);
+        } else {
+            stored_state_buffer[0] = tree_compressor->insert(buffer);
+        }
+    } else {
+        copy(buffer, buffer + stored_state_size, stored_state_buffer.begin());
+    }
+    stored_state_buffer[stored_state_size] = hash;
+    state_data_pool.push_back(stored_state_buffer.data());
+}
+
 StateID StateRegistry::insert_id_or_pop_state() {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
@@ -43,6 +133,11 @@ StateID StateRegistry::insert_id_or_pop_state() {
 }
 
 GlobalState StateRegistry::lookup_state(StateID id) const {
+    if (tree_compressor) {
+        auto buffer = make_shared<vector<PackedStateBin>>(get_bins_per_state());
+        tree_compressor->decompress(state_data_pool[id.value][0], buffer->data());
+        return GlobalState(move(buffer), *this, id);
+    }
     return GlobalState(state_data_pool[id.value], *this, id);
 }
 
@@ -56,8 +151,8 @@ const GlobalState &StateRegistry::get_initial_state() {
         for (size_t i = 0; i < initial_state.size(); ++i) {
             state_packer.set(buffer, i, initial_state[i].get_value());
         }
-        state_data_pool.push_back(buffer);
-        // buffer is copied by push_back
+        push_state(buffer, compute_hash(buffer));
+        // buffer is copied by push_state
         delete[] buffer;
         StateID id = insert_id_or_pop_state();
         cached_initial_state = new GlobalState(lookup_state(id));
@@ -69,20 +164,71 @@ const GlobalState &StateRegistry::get_initial_state() {
 //     out of the StateRegistry. This could for example be done by global functions
 //     operating on state buffers (PackedStateBin *).
 GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, const OperatorProxy &op) {
-    assert(!op.is_axiom());
-    state_data_pool.push_back(predecessor.get_packed_buffer());
-    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
-    for (EffectProxy effect : op.get_effects()) {
-        if (does_fire(effect, predecessor)) {
-            FactPair effect_pair = effect.get_fact().get_pair();
-            state_packer.set(buffer, effect_pair.var, effect_pair.value);
-        }
+    PROFILE_SCOPE("StateRegistry::get_successor_state");
+    successor_buffers.resize(get_bins_per_state());
+    PackedStateBin *buffer = successor_buffers.data();
+    int_hash_set::HashType hash = generate_successor(predecessor, op, buffer);
+    push_state(buffer, hash, &predecessor);
+    StateID id = insert_id_or_pop_state();
+    if (tree_compressor) {
+        // Hand out a copy of the successor instead of decompressing it again.
+        return GlobalState(
+            make_shared<vector<PackedStateBin>>(
+                successor_buffers.begin(), successor_buffers.end()),
+            *this, id);
+    }
+    return lookup_state(id);
+}
+
+void StateRegistry::get_successor_states(
+    const GlobalState &predecessor, const vector<OperatorID> &op_ids,
+    vector<StateID> &successor_ids) {
+    PROFILE_SCOPE("StateRegistry::get_successor_states");
+    int bins_per_state = get_bins_per_state();
+    int num_successors = op_ids.size();
+    successor_buffers.resize(num_successors * bins_per_state);
+    successor_hashes.resize(num_successors);
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (int i = 0; i < num_successors; ++i) {
+        successor_hashes[i] = generate_successor(
+            predecessor, operators[op_ids[i]],
+            &successor_buffers[i * bins_per_state]);
     }
-    axiom_evaluator.evaluate(buffer, state_packer);
+
+    successor_ids.reserve(successor_ids.size() + num_successors);
+    for (int i = 0; i < num_successors; ++i) {
+        push_state(&successor_buffers[i * bins_per_state], successor_hashes[i],
+                   &predecessor);
+        successor_ids.push_back(insert_id_or_pop_state());
+    }
+}
+
+GlobalState StateRegistry::insert_packed_state(const PackedStateBin *buffer) {
+    push_state(buffer, compute_hash(buffer));
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
 
+StateID StateRegistry::find_state(const PackedStateBin *buffer) const {
+    int stored_state_size = get_stored_state_size();
+    PackedStateBin root;
+    const PackedStateBin *stored_state = buffer;
+    if (tree_compressor) {
+        if (!tree_compressor->find(buffer, root)) {
+            return StateID::no_state;
+        }
+        stored_state = &root;
+    }
+    int id = registered_states.find_if(
+        compute_hash(buffer),
+        [this, stored_state, stored_state_size](int other) {
+            const PackedStateBin *other_state = state_data_pool[other];
+            return equal(stored_state, stored_state + stored_state_size,
+                         other_state);
+        });
+    return id == -1 ? StateID::no_state : StateID(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -91,7 +237,22 @@ int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
+size_t StateRegistry::get_memory_in_bytes() const {
+    size_t memory = state_data_pool.size() * (get_stored_state_size() + 1) *
+        sizeof(PackedStateBin) + registered_states.get_memory_in_bytes();
+    if (tree_compressor) {
+        memory += tree_compressor->get_memory_in_bytes();
+    }
+    return memory;
+}
+
 void StateRegistry::print_statistics() const {
     utils::g_log << "Number of registered states: " << size() << endl;
+    if (tree_compressor) {
+        utils::g_log << "Number of state tree nodes: "
+                     << tree_compressor->get_num_nodes() << endl;
+        utils::g_log << "State registry memory: "
+                     << get_memory_in_bytes() << " bytes" << endl;
+    }
     registered_states.print_statistics();
 }
@@ -10,9 +10,12 @@
 #include "algorithms/int_packer.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
+#include "algorithms/tree_compression.h"
 #include "utils/hash.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -24,8 +27,10 @@
     State first.
     A GlobalState is always registered in a StateRegistry and has a valid ID.
     It can (only) be constructed from a StateRegistry by factory methods for
-    the initial state and successor states. It never owns the actual state data
-    which is borrowed from the StateRegistry that created it.
+    the initial state and successor states. Usually, it does not own the actual
+    state data, which is borrowed from the StateRegistry that created it. Only
+    registries that store states in compressed form (see below) hand out
+    GlobalStates that share ownership of a decompressed copy of the data.
 
   State
     This class is used for fast access to state data. It contains and owns all
@@ -61,6 +66,14 @@
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
 
+  TreeCompressor
+    Optionally, the StateRegistry stores states in compressed form: the
+    packed data of all states is interned in a shared tree of nodes (see
+    algorithms/tree_compression.h) and the SegmentedArrayVector only stores
+    the root of each state's tree. Since equal states have equal roots,
+    duplicate detection works on the roots alone. Looking up a state
+    decompresses its data into a copy that is owned by the GlobalState.
+
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
     Can be thought of as a very compactly implemented map from GlobalState to T.
@@ -81,18 +94,19 @@
 
   Solution:
 
-    SearchNodeInfo
-      Remaining part of a search node besides the state that needs to be stored.
+    SearchNodeInfoLayout
+      Remaining part of a search node besides the state that needs to be stored,
+      encoded in a few ints per state.
 
     SearchNode
-      A SearchNode combines a StateID, a reference to a SearchNodeInfo and
-      OperatorCost. It is generated for easier access and not intended for long
+      A SearchNode combines a StateID, a view of its search node information
+      and its layout (SearchNodeInfoLayout). It is generated for easier access and not intended for long
       term storage. The state data is only stored once an can be accessed
       through the StateID.
 
     SearchSpace
-      The SearchSpace uses PerStateInformation<SearchNodeInfo> to map StateIDs to
-      SearchNodeInfos. The open lists only have to store StateIDs which can be
+      The SearchSpace uses PerStateArray<int> to map StateIDs to search node
+      information. The open lists only have to store StateIDs which can be
       used to look up a search node in the SearchSpace on demand.
 
   ---------------
@@ -109,6 +123,12 @@
 */
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+public:
+    /*
+      Hash and equality functors for IDs of states stored in the given
+      state data pool. They are public so that other state stores (see
+      ConcurrentStateRegistry) can detect duplicates in the same way.
+    */
     struct StateIDSemanticHash {
         const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
@@ -119,14 +139,37 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
               state_size(state_size) {
         }
 
-        int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
+        static int_hash_set::HashType hash_packed_state(
+            const PackedStateBin *data, int state_size) {
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
             }
             return hash_state.get_hash32();
         }
+
+        int_hash_set::HashType operator()(int id) const {
+            return hash_packed_state(state_data_pool[id], state_size);
+        }
+    };
+
+    /*
+      Hash functor for IDs of states whose hash is stored in the state data
+      pool directly after the state data, at the given index.
+    */
+    struct StateIDStoredHash {
+        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        int hash_index;
+        StateIDStoredHash(
+            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            int hash_index)
+            : state_data_pool(state_data_pool),
+              hash_index(hash_index) {
+        }
+
+        int_hash_set::HashType operator()(int id) const {
+            return state_data_pool[id][hash_index];
+        }
     };
 
     struct StateIDSemanticEqual {
@@ -146,27 +189,79 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
         }
     };
 
+private:
+
     /*
       Hash set of StateIDs used to detect states that are already registered in
       this registry and find their IDs. States are compared/hashed semantically,
       i.e. the actual state data is compared, not the memory location.
     */
-    using StateIDSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+    using StateIDSet = int_hash_set::IntHashSet<StateIDStoredHash, StateIDSemanticEqual>;
 
     TaskProxy task_proxy;
     const int_packer::IntPacker &state_packer;
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
+    // Only used if states are stored in compressed form.
+    std::unique_ptr<tree_compression::TreeCompressor> tree_compressor;
 
+    /*
+      Packed data of all registered states or, if states are compressed,
+      the roots of their trees. Each entry is followed by the hash of the
+      state.
+    */
     segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
     StateIDSet registered_states;
 
     GlobalState *cached_initial_state;
 
+    /*
+      Zobrist hashing: the hash of a state is the XOR of random keys for
+      its facts. Hence, the hash of a successor can be derived from the
+      hash of its predecessor with one update per changed variable
+      instead of hashing all of its data.
+    */
+    std::vector<int_hash_set::HashType> zobrist_keys;
+    // Index of the key for value 0 of each variable in zobrist_keys.
+    std::vector<int> zobrist_offsets;
+    std::vector<int> derived_variables;
+
+    // Scratch space for get_successor_state(s).
+    std::vector<PackedStateBin> successor_buffers;
+    std::vector<int_hash_set::HashType> successor_hashes;
+    // Scratch space for push_state.
+    std::vector<PackedStateBin> stored_state_buffer;
+
+    int get_stored_state_size() const;
+
+    int_hash_set::HashType get_zobrist_key(int var, int value) const {
+        return zobrist_keys[zobrist_offsets[var] + value];
+    }
+
+    int_hash_set::HashType compute_hash(const PackedStateBin *buffer) const;
+    /*
+      Write the successor of the predecessor (which must be registered in
+      this registry) under op to buffer and return its hash.
+    */
+    int_hash_set::HashType generate_successor(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
+    /*
+      Add the state with the given hash to the end of state_data_pool. If
+      states are compressed, the data of the predecessor (if given) is used
+      to speed up compression.
+    */
+    void push_state(const PackedStateBin *buffer, int_hash_set::HashType hash,
+                    const GlobalState *predecessor = nullptr);
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      If compress_states is true, the registry uses tree compression for
+      storing states, which needs less memory for tasks with many state
+      variables but makes registering and looking up states slower.
+    */
+    explicit StateRegistry(const TaskProxy &task_proxy,
+                           bool compress_states = false);
     ~StateRegistry();
 
     const TaskProxy &get_task_proxy() const {
@@ -181,6 +276,10 @@ public:
         return state_packer.get(buffer, var);
     }
 
+    void unpack_state(const PackedStateBin *buffer, int *values) const {
+        state_packer.unpack(buffer, values);
+    }
+
     /*
       Returns the state that was registered at the given ID. The ID must refer
       to a state in this registry. Do not mix IDs from from different registries.
@@ -200,6 +299,34 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      Computes the successors of predecessor for all given operators,
+      registers those that were not registered before and appends their IDs
+      to successor_ids (in the order of op_ids). All successors are first
+      generated in a scratch buffer and only then hashed and inserted, so
+      the two phases work on contiguous memory one after the other.
+    */
+    void get_successor_states(
+        const GlobalState &predecessor, const std::vector<OperatorID> &op_ids,
+        std::vector<StateID> &successor_ids);
+
+    /*
+      Returns the state with the given packed state data and registers it if
+      this was not done before. The buffer must contain get_bins_per_state()
+      bins and the values of derived variables must already be set. The
+      buffer is copied, so the caller keeps ownership.
+    */
+    GlobalState insert_packed_state(const PackedStateBin *buffer);
+
+    /*
+      Returns the ID of the state with the given packed state data if it is
+      registered and StateID::no_state otherwise. Unlike insert_packed_state,
+      this never registers the state.
+    */
+    StateID find_state(const PackedStateBin *buffer) const;
+
+    int get_bins_per_state() const;
+
     /*
       Returns the number of states registered so far.
     */
@@ -209,6 +336,16 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    /*
+      Returns the approximate memory used for the (compressed) state data
+      and the hash set of registered states.
+    */
+    size_t get_memory_in_bytes() const;
+
+    double get_hash_set_load_factor() const {
+        return registered_states.get_load_factor();
+    }
+
     void print_statistics() const;
 
     class const_iterator : public std::iterator<
@@ -80,7 +80,7 @@ class CausalGraph;
   OperatorProxy and GlobalOperator objects.
 
       int FantasyHeuristic::compute_heuristic(const GlobalState &global_state) {
-          State state = convert_global_state(global_state);
+          const State &state = convert_global_state(global_state);
           set_preferred(task->get_operators()[42]);
           int sum = 0;
           for (FactProxy fact : state)
@@ -562,6 +562,7 @@ bool does_fire(const EffectProxy &effect, const GlobalState &state);
 
 
 class State {
+    friend class TaskProxy;
     const AbstractTask *task;
     std::vector<int> values;
 public:
@@ -698,6 +699,19 @@ public:
         return create_state(std::move(state_values));
     }
 
+    /*
+      Convert a registered state of an ancestor task (see above) and
+      store the result in the given state of this task. This reuses the
+      memory of the given state, so repeated conversions into the same
+      state do not allocate memory.
+    */
+    void convert_ancestor_state(
+        const GlobalState &ancestor_state, State &state) const {
+        assert(state.task == task);
+        ancestor_state.unpack(state.values);
+        task->convert_state_values(state.values, ancestor_state.get_task().task);
+    }
+
     const causal_graph::CausalGraph &get_causal_graph() const;
 };
 
@@ -3,27 +3,53 @@
 #include "successor_generator_factory.h"
 #include "successor_generator_internals.h"
 
+#include "task_properties.h"
+
 #include "../abstract_task.h"
 #include "../global_state.h"
 
+#include "../utils/memory.h"
+#include "../utils/profiling.h"
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type)
     : root(SuccessorGeneratorFactory(task_proxy).create()) {
+    if (type == SuccessorGeneratorType::FLAT) {
+        flat_generator = utils::make_unique_ptr<FlatGenerator>(
+            *root, task_properties::g_state_packers[task_proxy]);
+        root = nullptr;
+    }
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
 
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    PROFILE_SCOPE("SuccessorGenerator::generate_applicable_ops(State)");
+    if (flat_generator)
+        flat_generator->generate_applicable_ops(state, applicable_ops);
+    else
+        root->generate_applicable_ops(state, applicable_ops);
 }
 
 void SuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    PROFILE_SCOPE("SuccessorGenerator::generate_applicable_ops(GlobalState)");
+    if (flat_generator)
+        flat_generator->generate_applicable_ops(state, applicable_ops);
+    else
+        root->generate_applicable_ops(state, applicable_ops);
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+
+PerTaskInformation<SuccessorGenerator> g_flat_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorType::FLAT);
+    }
+    );
 }
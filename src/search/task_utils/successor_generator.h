@@ -12,13 +12,23 @@ class State;
 class TaskProxy;
 
 namespace successor_generator {
+class FlatGenerator;
 class GeneratorBase;
 
+enum class SuccessorGeneratorType {
+    TREE,
+    FLAT
+};
+
 class SuccessorGenerator {
+    // Exactly one of the two representations is used.
     std::unique_ptr<GeneratorBase> root;
+    std::unique_ptr<FlatGenerator> flat_generator;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -34,6 +44,7 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_flat_successor_generators;
 }
 
 #endif
@@ -3,6 +3,10 @@
 #include "../global_state.h"
 #include "../task_proxy.h"
 
+#include "../algorithms/int_packer.h"
+#include "../utils/system.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -22,7 +26,9 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (FlatGenerator
+    implements a variant of this that can be selected with the
+    successor_generator option of the search engines.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -69,6 +75,27 @@ using namespace std;
 */
 
 namespace successor_generator {
+// Node types of FlatGenerator.
+enum FlatNodeType {
+    FORK,
+    SWITCH_VECTOR,
+    SWITCH_SORTED,
+    SWITCH_SINGLE,
+    LEAF
+};
+
+// Number of ints used for storing a variable in the code of FlatGenerator.
+static const int VAR_SIZE = 4;
+
+static void add_variable(
+    vector<int> &code, int var, const int_packer::IntPacker &state_packer) {
+    int bin_index;
+    int shift;
+    PackedStateBin read_mask;
+    state_packer.get_location(var, bin_index, shift, read_mask);
+    code.insert(code.end(), {var, bin_index, shift, static_cast<int>(read_mask)});
+}
+
 GeneratorForkBinary::GeneratorForkBinary(
     unique_ptr<GeneratorBase> generator1,
     unique_ptr<GeneratorBase> generator2)
@@ -93,6 +120,17 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkBinary::compile(
+    vector<int> &code, const int_packer::IntPacker &state_packer) const {
+    int pos = code.size();
+    code.insert(code.end(), {FORK, 2, -1, -1});
+    int child1 = generator1->compile(code, state_packer);
+    code[pos + 2] = child1;
+    int child2 = generator2->compile(code, state_packer);
+    code[pos + 3] = child2;
+    return pos;
+}
+
 GeneratorForkMulti::GeneratorForkMulti(vector<unique_ptr<GeneratorBase>> children)
     : children(move(children)) {
     /* Note that we permit 0-ary forks as a way to define empty
@@ -114,6 +152,20 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkMulti::compile(
+    vector<int> &code, const int_packer::IntPacker &state_packer) const {
+    int pos = code.size();
+    int num_children = children.size();
+    code.push_back(FORK);
+    code.push_back(num_children);
+    code.resize(code.size() + num_children, -1);
+    for (int i = 0; i < num_children; ++i) {
+        int child = children[i]->compile(code, state_packer);
+        code[pos + 2 + i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id, vector<unique_ptr<GeneratorBase>> &&generator_for_value)
     : switch_var_id(switch_var_id),
@@ -138,6 +190,24 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchVector::compile(
+    vector<int> &code, const int_packer::IntPacker &state_packer) const {
+    int pos = code.size();
+    code.push_back(SWITCH_VECTOR);
+    add_variable(code, switch_var_id, state_packer);
+    int domain_size = generator_for_value.size();
+    code.push_back(domain_size);
+    int children_pos = code.size();
+    code.resize(code.size() + domain_size, -1);
+    for (int value = 0; value < domain_size; ++value) {
+        if (generator_for_value[value]) {
+            int child = generator_for_value[value]->compile(code, state_packer);
+            code[children_pos + value] = child;
+        }
+    }
+    return pos;
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>> &&generator_for_value)
@@ -165,6 +235,29 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchHash::compile(
+    vector<int> &code, const int_packer::IntPacker &state_packer) const {
+    int pos = code.size();
+    vector<int> values;
+    values.reserve(generator_for_value.size());
+    for (const auto &item : generator_for_value)
+        values.push_back(item.first);
+    sort(values.begin(), values.end());
+    int num_values = values.size();
+
+    code.push_back(SWITCH_SORTED);
+    add_variable(code, switch_var_id, state_packer);
+    code.push_back(num_values);
+    code.insert(code.end(), values.begin(), values.end());
+    int children_pos = code.size();
+    code.resize(code.size() + num_values, -1);
+    for (int i = 0; i < num_values; ++i) {
+        int child = generator_for_value.at(values[i])->compile(code, state_packer);
+        code[children_pos + i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id, int value, unique_ptr<GeneratorBase> generator_for_value)
     : switch_var_id(switch_var_id),
@@ -186,6 +279,18 @@ void GeneratorSwitchSingle::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchSingle::compile(
+    vector<int> &code, const int_packer::IntPacker &state_packer) const {
+    int pos = code.size();
+    code.push_back(SWITCH_SINGLE);
+    add_variable(code, switch_var_id, state_packer);
+    code.push_back(value);
+    code.push_back(-1);
+    int child = generator_for_value->compile(code, state_packer);
+    code[pos + VAR_SIZE + 2] = child;
+    return pos;
+}
+
 GeneratorLeafVector::GeneratorLeafVector(vector<OperatorID> &&applicable_operators)
     : applicable_operators(move(applicable_operators)) {
 }
@@ -212,6 +317,16 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+int GeneratorLeafVector::compile(
+    vector<int> &code, const int_packer::IntPacker &) const {
+    int pos = code.size();
+    code.push_back(LEAF);
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators)
+        code.push_back(id.get_index());
+    return pos;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator) {
 }
@@ -225,4 +340,91 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const GlobalState &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+int GeneratorLeafSingle::compile(
+    vector<int> &code, const int_packer::IntPacker &) const {
+    int pos = code.size();
+    code.insert(code.end(), {LEAF, 1, applicable_operator.get_index()});
+    return pos;
+}
+
+
+FlatGenerator::FlatGenerator(
+    const GeneratorBase &root, const int_packer::IntPacker &state_packer) {
+    root.compile(code, state_packer);
+    code.shrink_to_fit();
+}
+
+template<typename ValueReader>
+void FlatGenerator::generate_applicable_ops(
+    int pos, const ValueReader &read_value,
+    vector<OperatorID> &applicable_ops) const {
+    /*
+      Instead of recursing into the last child of a node, we continue
+      the loop with it. This way, we only recurse for forks.
+    */
+    while (true) {
+        const int *node = &code[pos];
+        switch (node[0]) {
+        case FORK: {
+            int num_children = node[1];
+            if (num_children == 0)
+                return;
+            for (int i = 0; i < num_children - 1; ++i)
+                generate_applicable_ops(node[2 + i], read_value, applicable_ops);
+            pos = node[2 + num_children - 1];
+            break;
+        }
+        case SWITCH_VECTOR: {
+            int value = read_value(node + 1);
+            pos = node[2 + VAR_SIZE + value];
+            if (pos == -1)
+                return;
+            break;
+        }
+        case SWITCH_SORTED: {
+            int value = read_value(node + 1);
+            int num_values = node[1 + VAR_SIZE];
+            const int *values = node + 2 + VAR_SIZE;
+            const int *it = lower_bound(values, values + num_values, value);
+            if (it == values + num_values || *it != value)
+                return;
+            pos = values[num_values + (it - values)];
+            break;
+        }
+        case SWITCH_SINGLE: {
+            if (read_value(node + 1) != node[1 + VAR_SIZE])
+                return;
+            pos = node[2 + VAR_SIZE];
+            break;
+        }
+        case LEAF: {
+            int num_operators = node[1];
+            for (int i = 0; i < num_operators; ++i)
+                applicable_ops.emplace_back(node[2 + i]);
+            return;
+        }
+        default:
+            ABORT("Unknown node type in flat successor generator.");
+        }
+    }
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    generate_applicable_ops(
+        0, [&state](const int *var) {return state[var[0]].get_value();},
+        applicable_ops);
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    const PackedStateBin *buffer = state.get_packed_buffer();
+    generate_applicable_ops(
+        0, [buffer](const int *var) {
+            return static_cast<int>(
+                (buffer[var[1]] & static_cast<PackedStateBin>(var[3])) >> var[2]);
+        },
+        applicable_ops);
+}
 }
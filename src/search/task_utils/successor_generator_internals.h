@@ -10,6 +10,10 @@
 class GlobalState;
 class State;
 
+namespace int_packer {
+class IntPacker;
+}
+
 namespace successor_generator {
 class GeneratorBase {
 public:
@@ -20,6 +24,13 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const = 0;
+
+    /*
+      Append the representation of the subtree rooted at this node to the
+      code of a FlatGenerator and return the position of the node.
+    */
+    virtual int compile(
+        std::vector<int> &code, const int_packer::IntPacker &state_packer) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -34,6 +45,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -45,6 +59,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -59,6 +76,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -73,6 +93,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -88,6 +111,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -99,6 +125,9 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -110,6 +139,53 @@ public:
     // Transitional method, used until the search is switched to the new task interface.
     virtual void generate_applicable_ops(
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(
+        std::vector<int> &code,
+        const int_packer::IntPacker &state_packer) const override;
+};
+
+/*
+  Successor generator that stores the tree in a single vector of ints in
+  the "byte-code" style discussed in successor_generator_internals.cc.
+  Child nodes are referenced by their position in the vector. Every node
+  starts with its node type:
+
+  - fork: [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, <var>, k, child_0, ..., child_{k-1}]
+    where k is the domain size and missing children are -1
+  - sorted switch: [SWITCH_SORTED, <var>, k, value_1, ..., value_k,
+    child_1, ..., child_k] with value_1 < ... < value_k
+  - single switch: [SWITCH_SINGLE, <var>, value, child]
+  - leaf: [LEAF, n, op_id_1, ..., op_id_n]
+
+  <var> consists of the variable ID and the location of the variable in
+  packed state buffers (bin index, shift and read mask; see
+  IntPacker::get_location), so that the values of GlobalStates can be
+  read without going through the state packer.
+
+  Traversing the code needs no virtual calls and follows the chains of
+  single switches that are typical for operators with many
+  preconditions in a loop.
+*/
+class FlatGenerator {
+    std::vector<int> code;
+
+    template<typename ValueReader>
+    void generate_applicable_ops(
+        int pos, const ValueReader &read_value,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    FlatGenerator(
+        const GeneratorBase &root, const int_packer::IntPacker &state_packer);
+
+    void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const;
+    void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const;
+
+    int get_code_size() const {
+        return code.size();
+    }
 };
 }
 
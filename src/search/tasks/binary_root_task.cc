@@ -0,0 +1,630 @@
+#include "binary_root_task.h"
+
+#include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using utils::ExitCode;
+
+namespace tasks {
+const char BINARY_TASK_MAGIC[8] = {'\x7f', 'F', 'D', 'S', 'A', 'S', '\0', '\0'};
+static const int BINARY_TASK_VERSION = 1;
+static const int BYTE_ORDER_MARK = 0x01020304;
+static const string AXIOM_NAME = "<axiom>";
+
+static void input_error(const string &message) {
+    cerr << "Invalid binary task: " << message << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+/*
+  Memory holding a binary task. The memory is either a read-only mapping
+  of the input file or a buffer into which the input stream was read.
+*/
+class TaskBuffer {
+    vector<char> buffer;
+    const char *data;
+    size_t size;
+    bool is_mapped;
+
+    bool try_to_map_stdin() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        struct stat file_info;
+        if (fstat(STDIN_FILENO, &file_info) != 0 || !S_ISREG(file_info.st_mode) ||
+            file_info.st_size < static_cast<off_t>(sizeof(BINARY_TASK_MAGIC)))
+            return false;
+        void *address = mmap(nullptr, file_info.st_size, PROT_READ, MAP_PRIVATE,
+                             STDIN_FILENO, 0);
+        if (address == MAP_FAILED)
+            return false;
+        data = static_cast<const char *>(address);
+        size = file_info.st_size;
+        /*
+          We can only map the whole file. This is only correct if nothing
+          was read before the task, which we check via the magic string.
+        */
+        if (memcmp(data, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) != 0) {
+            munmap(address, size);
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+public:
+    explicit TaskBuffer(istream &in)
+        : data(nullptr), size(0), is_mapped(false) {
+        if (&in == &cin)
+            is_mapped = try_to_map_stdin();
+        if (!is_mapped) {
+            buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+    }
+
+    ~TaskBuffer() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+        if (is_mapped)
+            munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    TaskBuffer(const TaskBuffer &) = delete;
+    TaskBuffer &operator=(const TaskBuffer &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    size_t get_size() const {
+        return size;
+    }
+
+    bool is_memory_mapped() const {
+        return is_mapped;
+    }
+};
+
+
+// View of an int array inside the task buffer.
+struct IntArray {
+    const int *data = nullptr;
+    int size = 0;
+
+    int operator[](int index) const {
+        assert(index >= 0 && index < size);
+        return data[index];
+    }
+
+    FactPair get_fact(int index) const {
+        assert(2 * index + 1 < size);
+        return FactPair(data[2 * index], data[2 * index + 1]);
+    }
+
+    int back() const {
+        assert(size > 0);
+        return data[size - 1];
+    }
+};
+
+
+class BufferReader {
+    const char *data;
+    size_t size;
+    size_t pos;
+
+    int read_int() {
+        if (pos + sizeof(int) > size)
+            input_error("unexpected end of file");
+        int result;
+        memcpy(&result, data + pos, sizeof(int));
+        pos += sizeof(int);
+        return result;
+    }
+
+public:
+    explicit BufferReader(const TaskBuffer &buffer)
+        : data(buffer.get_data()), size(buffer.get_size()), pos(0) {
+        if (size < sizeof(BINARY_TASK_MAGIC) ||
+            memcmp(data, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) != 0)
+            input_error("wrong magic string");
+        pos = sizeof(BINARY_TASK_MAGIC);
+        int version = read_int();
+        int byte_order_mark = read_int();
+        if (byte_order_mark != BYTE_ORDER_MARK)
+            input_error("task was written on a machine with different byte order");
+        if (version != BINARY_TASK_VERSION) {
+            input_error("expected version " + to_string(BINARY_TASK_VERSION) +
+                        ", got " + to_string(version));
+        }
+    }
+
+    /*
+      Read an array of the given size. A negative size means that the
+      size is not known in advance.
+    */
+    IntArray read_array(int expected_size = -1) {
+        IntArray result;
+        result.size = read_int();
+        if (result.size < 0 ||
+            (expected_size >= 0 && result.size != expected_size))
+            input_error("unexpected array size");
+        if (static_cast<size_t>(result.size) > (size - pos) / sizeof(int))
+            input_error("unexpected end of file");
+        // The buffer starts at an aligned address and pos is a multiple of 4.
+        result.data = reinterpret_cast<const int *>(data + pos);
+        pos += result.size * sizeof(int);
+        return result;
+    }
+
+    const char *read_chars(int expected_size) {
+        int num_chars = read_int();
+        if (num_chars != expected_size || static_cast<size_t>(num_chars) > size - pos)
+            input_error("unexpected size of name block");
+        const char *result = data + pos;
+        pos += num_chars;
+        return result;
+    }
+};
+
+
+/*
+  Offsets index into the memory of the task, so we check all of them
+  when loading the task instead of relying on assertions.
+*/
+static void verify_offsets(const IntArray &offsets, int num_entries) {
+    if (offsets[0] != 0 || offsets.back() != num_entries)
+        input_error("inconsistent offsets");
+    for (int i = 1; i < offsets.size; ++i) {
+        if (offsets[i] < offsets[i - 1])
+            input_error("offsets are not monotonic");
+    }
+}
+
+static void verify_offsets(const IntArray &offsets, const IntArray &facts) {
+    if (facts.size % 2 != 0)
+        input_error("odd size of fact array");
+    verify_offsets(offsets, facts.size / 2);
+}
+
+static void verify_facts(const IntArray &facts, const IntArray &domain_sizes) {
+    for (int i = 0; i < facts.size / 2; ++i) {
+        FactPair fact = facts.get_fact(i);
+        if (fact.var < 0 || fact.var >= domain_sizes.size ||
+            fact.value < 0 || fact.value >= domain_sizes[fact.var])
+            input_error("fact out of range");
+    }
+}
+
+
+struct ActionTable {
+    IntArray costs;
+    IntArray precondition_offsets;
+    IntArray preconditions;
+    IntArray effect_offsets;
+    IntArray effects;
+    IntArray effect_condition_offsets;
+    IntArray effect_conditions;
+
+    ActionTable(BufferReader &reader, const IntArray &domain_sizes) {
+        costs = reader.read_array();
+        int num_actions = costs.size;
+        precondition_offsets = reader.read_array(num_actions + 1);
+        preconditions = reader.read_array();
+        verify_offsets(precondition_offsets, preconditions);
+        verify_facts(preconditions, domain_sizes);
+        effect_offsets = reader.read_array(num_actions + 1);
+        effects = reader.read_array();
+        verify_offsets(effect_offsets, effects);
+        verify_facts(effects, domain_sizes);
+        effect_condition_offsets = reader.read_array(effects.size / 2 + 1);
+        effect_conditions = reader.read_array();
+        verify_offsets(effect_condition_offsets, effect_conditions);
+        verify_facts(effect_conditions, domain_sizes);
+    }
+
+    int get_effect_id(int action, int effect) const {
+        assert(effect >= 0 && effect < get_num_effects(action));
+        return effect_offsets[action] + effect;
+    }
+
+    int get_num_preconditions(int action) const {
+        return precondition_offsets[action + 1] - precondition_offsets[action];
+    }
+
+    FactPair get_precondition(int action, int index) const {
+        assert(index >= 0 && index < get_num_preconditions(action));
+        return preconditions.get_fact(precondition_offsets[action] + index);
+    }
+
+    int get_num_effects(int action) const {
+        return effect_offsets[action + 1] - effect_offsets[action];
+    }
+
+    FactPair get_effect(int action, int effect) const {
+        return effects.get_fact(get_effect_id(action, effect));
+    }
+
+    int get_num_effect_conditions(int action, int effect) const {
+        int effect_id = get_effect_id(action, effect);
+        return effect_condition_offsets[effect_id + 1] -
+               effect_condition_offsets[effect_id];
+    }
+
+    FactPair get_effect_condition(int action, int effect, int index) const {
+        assert(index >= 0 && index < get_num_effect_conditions(action, effect));
+        int effect_id = get_effect_id(action, effect);
+        return effect_conditions.get_fact(
+            effect_condition_offsets[effect_id] + index);
+    }
+};
+
+
+class BinaryRootTask : public AbstractTask {
+    unique_ptr<TaskBuffer> buffer;
+    IntArray domain_sizes;
+    IntArray axiom_layers;
+    IntArray default_axiom_values;
+    IntArray initial_state_values;
+    IntArray goals;
+    IntArray fact_offsets;
+    IntArray mutex_offsets;
+    IntArray mutexes;
+    unique_ptr<ActionTable> operators;
+    unique_ptr<ActionTable> axioms;
+    IntArray name_offsets;
+    const char *names;
+
+    const ActionTable &get_actions(bool is_axiom) const {
+        return is_axiom ? *axioms : *operators;
+    }
+
+    int get_fact_id(const FactPair &fact) const {
+        assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    string get_name(int index) const {
+        return string(names + name_offsets[index],
+                      name_offsets[index + 1] - name_offsets[index]);
+    }
+
+public:
+    explicit BinaryRootTask(unique_ptr<TaskBuffer> buffer_);
+
+    virtual int get_num_variables() const override {
+        return domain_sizes.size;
+    }
+
+    virtual string get_variable_name(int var) const override {
+        return get_name(var);
+    }
+
+    virtual int get_variable_domain_size(int var) const override {
+        return domain_sizes[var];
+    }
+
+    virtual int get_variable_axiom_layer(int var) const override {
+        return axiom_layers[var];
+    }
+
+    virtual int get_variable_default_axiom_value(int var) const override {
+        return default_axiom_values[var];
+    }
+
+    virtual string get_fact_name(const FactPair &fact) const override {
+        return get_name(get_num_variables() + get_fact_id(fact));
+    }
+
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override {
+        return get_actions(is_axiom).costs[index];
+    }
+
+    virtual string get_operator_name(int index, bool is_axiom) const override {
+        if (is_axiom)
+            return AXIOM_NAME;
+        assert(index >= 0 && index < get_num_operators());
+        return get_name(get_num_variables() + fact_offsets.back() + index);
+    }
+
+    virtual int get_num_operators() const override {
+        return operators->costs.size;
+    }
+
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_num_preconditions(index);
+    }
+
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_precondition(op_index, fact_index);
+    }
+
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_num_effects(op_index);
+    }
+
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_num_effect_conditions(op_index, eff_index);
+    }
+
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_effect_condition(
+            op_index, eff_index, cond_index);
+    }
+
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override {
+        return get_actions(is_axiom).get_effect(op_index, eff_index);
+    }
+
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override {
+        if (this != ancestor_task) {
+            ABORT("Invalid operator ID conversion");
+        }
+        return index;
+    }
+
+    virtual int get_num_axioms() const override {
+        return axioms->costs.size;
+    }
+
+    virtual int get_num_goals() const override {
+        return goals.size / 2;
+    }
+
+    virtual FactPair get_goal_fact(int index) const override {
+        return goals.get_fact(index);
+    }
+
+    virtual vector<int> get_initial_state_values() const override {
+        return vector<int>(initial_state_values.data,
+                           initial_state_values.data + initial_state_values.size);
+    }
+
+    virtual void convert_state_values(
+        vector<int> &, const AbstractTask *ancestor_task) const override {
+        if (this != ancestor_task) {
+            ABORT("Invalid state conversion");
+        }
+    }
+};
+
+BinaryRootTask::BinaryRootTask(unique_ptr<TaskBuffer> buffer_)
+    : buffer(move(buffer_)) {
+    BufferReader reader(*buffer);
+    domain_sizes = reader.read_array();
+    int num_variables = domain_sizes.size;
+    for (int var = 0; var < num_variables; ++var) {
+        if (domain_sizes[var] <= 0)
+            input_error("invalid domain size");
+    }
+    axiom_layers = reader.read_array(num_variables);
+    default_axiom_values = reader.read_array(num_variables);
+    initial_state_values = reader.read_array(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        if (initial_state_values[var] < 0 ||
+            initial_state_values[var] >= domain_sizes[var])
+            input_error("initial state value out of range");
+    }
+    goals = reader.read_array();
+    if (goals.size == 0 || goals.size % 2 != 0)
+        input_error("invalid goal");
+    verify_facts(goals, domain_sizes);
+    fact_offsets = reader.read_array(num_variables + 1);
+    if (fact_offsets[0] != 0)
+        input_error("inconsistent fact offsets");
+    for (int var = 0; var < num_variables; ++var) {
+        if (fact_offsets[var + 1] - fact_offsets[var] != domain_sizes[var])
+            input_error("fact offsets do not match domain sizes");
+    }
+    int num_facts = fact_offsets.back();
+    mutex_offsets = reader.read_array(num_facts + 1);
+    mutexes = reader.read_array();
+    verify_offsets(mutex_offsets, mutexes);
+    verify_facts(mutexes, domain_sizes);
+    operators = utils::make_unique_ptr<ActionTable>(reader, domain_sizes);
+    axioms = utils::make_unique_ptr<ActionTable>(reader, domain_sizes);
+    int num_names = num_variables + num_facts + get_num_operators();
+    name_offsets = reader.read_array(num_names + 1);
+    verify_offsets(name_offsets, name_offsets.back());
+    names = reader.read_chars(name_offsets.back());
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int fact_id = get_fact_id(fact1);
+    int begin = mutex_offsets[fact_id];
+    int end = mutex_offsets[fact_id + 1];
+    // Binary search in the sorted mutex list of fact1.
+    while (begin < end) {
+        int middle = begin + (end - begin) / 2;
+        FactPair mutex = mutexes.get_fact(middle);
+        if (mutex == fact2)
+            return true;
+        else if (mutex < fact2)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return false;
+}
+
+
+bool is_binary_task(istream &in) {
+    return in.peek() == BINARY_TASK_MAGIC[0];
+}
+
+shared_ptr<AbstractTask> read_binary_root_task(istream &in) {
+    unique_ptr<TaskBuffer> buffer = utils::make_unique_ptr<TaskBuffer>(in);
+    if (buffer->is_memory_mapped())
+        utils::g_log << "mapped binary task into memory" << endl;
+    return make_shared<BinaryRootTask>(move(buffer));
+}
+
+
+class BinaryWriter {
+    ostream &out;
+
+public:
+    explicit BinaryWriter(ostream &out)
+        : out(out) {
+    }
+
+    void write_int(int value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(int));
+    }
+
+    void write_array(const vector<int> &values) {
+        write_int(values.size());
+        out.write(reinterpret_cast<const char *>(values.data()),
+                  values.size() * sizeof(int));
+    }
+
+    void write_chars(const string &chars) {
+        write_int(chars.size());
+        out.write(chars.data(), chars.size());
+    }
+};
+
+static void append_fact(vector<int> &facts, const FactPair &fact) {
+    facts.push_back(fact.var);
+    facts.push_back(fact.value);
+}
+
+static void write_action_table(
+    const AbstractTask &task, bool is_axiom, BinaryWriter &writer) {
+    int num_actions = is_axiom ? task.get_num_axioms() : task.get_num_operators();
+    vector<int> costs;
+    vector<int> precondition_offsets(1, 0);
+    vector<int> preconditions;
+    vector<int> effect_offsets(1, 0);
+    vector<int> effects;
+    vector<int> effect_condition_offsets(1, 0);
+    vector<int> effect_conditions;
+    costs.reserve(num_actions);
+    for (int action = 0; action < num_actions; ++action) {
+        costs.push_back(task.get_operator_cost(action, is_axiom));
+        int num_preconditions = task.get_num_operator_preconditions(
+            action, is_axiom);
+        for (int i = 0; i < num_preconditions; ++i) {
+            append_fact(preconditions,
+                        task.get_operator_precondition(action, i, is_axiom));
+        }
+        precondition_offsets.push_back(preconditions.size() / 2);
+        int num_effects = task.get_num_operator_effects(action, is_axiom);
+        for (int eff = 0; eff < num_effects; ++eff) {
+            append_fact(effects, task.get_operator_effect(action, eff, is_axiom));
+            int num_conditions = task.get_num_operator_effect_conditions(
+                action, eff, is_axiom);
+            for (int i = 0; i < num_conditions; ++i) {
+                append_fact(effect_conditions, task.get_operator_effect_condition(
+                                action, eff, i, is_axiom));
+            }
+            effect_condition_offsets.push_back(effect_conditions.size() / 2);
+        }
+        effect_offsets.push_back(effects.size() / 2);
+    }
+    writer.write_array(costs);
+    writer.write_array(precondition_offsets);
+    writer.write_array(preconditions);
+    writer.write_array(effect_offsets);
+    writer.write_array(effects);
+    writer.write_array(effect_condition_offsets);
+    writer.write_array(effect_conditions);
+}
+
+void write_binary_task(
+    const AbstractTask &task,
+    const vector<vector<vector<FactPair>>> &mutexes_by_fact,
+    ostream &out) {
+    BinaryWriter writer(out);
+    out.write(BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC));
+    writer.write_int(BINARY_TASK_VERSION);
+    writer.write_int(BYTE_ORDER_MARK);
+
+    int num_variables = task.get_num_variables();
+    vector<int> domain_sizes;
+    vector<int> axiom_layers;
+    vector<int> default_axiom_values;
+    vector<int> fact_offsets(1, 0);
+    for (int var = 0; var < num_variables; ++var) {
+        int domain_size = task.get_variable_domain_size(var);
+        domain_sizes.push_back(domain_size);
+        axiom_layers.push_back(task.get_variable_axiom_layer(var));
+        default_axiom_values.push_back(task.get_variable_default_axiom_value(var));
+        fact_offsets.push_back(fact_offsets.back() + domain_size);
+    }
+    writer.write_array(domain_sizes);
+    writer.write_array(axiom_layers);
+    writer.write_array(default_axiom_values);
+    writer.write_array(task.get_initial_state_values());
+
+    vector<int> goals;
+    for (int i = 0; i < task.get_num_goals(); ++i)
+        append_fact(goals, task.get_goal_fact(i));
+    writer.write_array(goals);
+    writer.write_array(fact_offsets);
+
+    vector<int> mutex_offsets(1, 0);
+    vector<int> mutexes;
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value = 0; value < domain_sizes[var]; ++value) {
+            vector<FactPair> mutex_facts = mutexes_by_fact[var][value];
+            sort(mutex_facts.begin(), mutex_facts.end());
+            for (const FactPair &fact : mutex_facts)
+                append_fact(mutexes, fact);
+            mutex_offsets.push_back(mutexes.size() / 2);
+        }
+    }
+    writer.write_array(mutex_offsets);
+    writer.write_array(mutexes);
+
+    write_action_table(task, false, writer);
+    write_action_table(task, true, writer);
+
+    vector<int> name_offsets(1, 0);
+    string names;
+    auto add_name = [&](const string &name) {
+            names += name;
+            name_offsets.push_back(names.size());
+        };
+    for (int var = 0; var < num_variables; ++var)
+        add_name(task.get_variable_name(var));
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value = 0; value < domain_sizes[var]; ++value)
+            add_name(task.get_fact_name(FactPair(var, value)));
+    }
+    for (int op = 0; op < task.get_num_operators(); ++op)
+        add_name(task.get_operator_name(op, false));
+    writer.write_array(name_offsets);
+    writer.write_chars(names);
+}
+}
@@ -0,0 +1,69 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include "../abstract_task.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/*
+  Binary serialization of the root task.
+
+  Parsing the textual translator output is slow for tasks with millions
+  of operators. The binary format stores the task in flat arrays of
+  32-bit ints in host byte order, so that a task file can be memory-mapped
+  and used without copying or parsing. The file consists of
+
+    - the 8-byte magic string BINARY_TASK_MAGIC,
+    - the format version and a byte order mark (one int each),
+    - a sequence of int arrays, each prefixed by its length, and
+    - the names of variables, facts and operators as one block of chars.
+
+  The arrays are (V = #variables, F = #facts, N = #operators,
+  A = #axioms):
+
+    domain sizes [V], axiom layers [V], default axiom values [V],
+    initial state values [V], goal facts [2 * #goals],
+    first fact index of each variable [V + 1],
+    start of the mutex list of each fact [F + 1], mutex facts,
+    action table for the operators, action table for the axioms,
+    start of the name of each variable, fact and operator [V + F + N + 1],
+
+  where facts are stored as consecutive (var, value) pairs and an action
+  table consists of
+
+    costs [N], start of the preconditions of each action [N + 1],
+    preconditions, start of the effects of each action [N + 1],
+    effect facts, start of the conditions of each effect [#effects + 1],
+    effect conditions.
+
+  The initial state values already include the values of derived
+  variables. The mutex list of each fact is sorted. Operator costs are
+  final, i.e., the translator's metric flag has already been applied.
+
+  Binary tasks are created by the search component itself
+  ("downward --write-binary-task FILE < output.sas") and are only
+  checked for structural consistency when they are loaded. The planner
+  accepts them in place of the textual format; if the input is a regular
+  file on stdin, it is mapped into memory instead of being read.
+*/
+
+namespace tasks {
+extern const char BINARY_TASK_MAGIC[8];
+
+// Return true iff the next char of the stream starts a binary task.
+extern bool is_binary_task(std::istream &in);
+extern std::shared_ptr<AbstractTask> read_binary_root_task(std::istream &in);
+
+/*
+  Write the task in binary format. For each fact, mutexes_by_fact
+  contains the facts of other variables that are mutex with it.
+*/
+extern void write_binary_task(
+    const AbstractTask &task,
+    const std::vector<std::vector<std::vector<FactPair>>> &mutexes_by_fact,
+    std::ostream &out);
+}
+
+#endif
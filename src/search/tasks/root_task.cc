@@ -1,5 +1,7 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../state_registry.h"
@@ -9,6 +11,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <fstream>
 #include <memory>
 #include <set>
 #include <unordered_set>
@@ -69,6 +72,8 @@ class RootTask : public AbstractTask {
 public:
     explicit RootTask(istream &in);
 
+    vector<vector<vector<FactPair>>> get_mutexes_by_fact() const;
+
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
     virtual int get_variable_domain_size(int var) const override;
@@ -382,6 +387,17 @@ const ExplicitOperator &RootTask::get_operator_or_axiom(
     }
 }
 
+vector<vector<vector<FactPair>>> RootTask::get_mutexes_by_fact() const {
+    vector<vector<vector<FactPair>>> mutexes_by_fact(mutexes.size());
+    for (size_t var = 0; var < mutexes.size(); ++var) {
+        for (const set<FactPair> &mutex_facts : mutexes[var]) {
+            mutexes_by_fact[var].emplace_back(
+                mutex_facts.begin(), mutex_facts.end());
+        }
+    }
+    return mutexes_by_fact;
+}
+
 int RootTask::get_num_variables() const {
     return variables.size();
 }
@@ -495,7 +511,25 @@ void RootTask::convert_state_values(
 
 void read_root_task(istream &in) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    if (is_binary_task(in))
+        g_root_task = read_binary_root_task(in);
+    else
+        g_root_task = make_shared<RootTask>(in);
+}
+
+void write_root_task_in_binary_format(const string &filename) {
+    shared_ptr<RootTask> root_task = dynamic_pointer_cast<RootTask>(g_root_task);
+    if (!root_task) {
+        cerr << "The input is already in binary format." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    ofstream out(filename, ios::binary);
+    write_binary_task(*root_task, root_task->get_mutexes_by_fact(), out);
+    out.close();
+    if (out.fail()) {
+        cerr << "Could not write binary task to " << filename << "." << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
@@ -5,6 +5,12 @@
 
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
+/*
+  Read the root task from the translator output or from a task in the
+  binary format of binary_root_task.h.
+*/
 extern void read_root_task(std::istream &in);
+// Write the root task read from translator output in binary format.
+extern void write_root_task_in_binary_format(const std::string &filename);
 }
 #endif
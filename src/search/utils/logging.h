@@ -4,7 +4,11 @@
 #include "system.h"
 #include "timer.h"
 
+#include <cstring>
+#include <iostream>
+#include <mutex>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -17,33 +21,88 @@ namespace utils {
   Simple logger that prepends time and peak memory info to messages.
   Logs are written to stdout.
 
+  Each thread collects its messages in its own buffer, which is written
+  to stdout at the end of each line, i.e., for std::endl, other stream
+  manipulators and strings ending in a newline. This way, threads can
+  log concurrently without mixing up their lines.
+
   Usage:
         utils::g_log << "States: " << num_states << endl;
 */
 class Log {
 private:
-    bool line_has_started = false;
+    struct LineBuffer {
+        std::ostringstream stream;
+        bool line_has_started = false;
+    };
+
+    /*
+      These functions are defined in the header, so that programs like
+      the microbenchmarks can use the logger without linking logging.cc,
+      which depends on the option parser.
+    */
+    static LineBuffer &get_line_buffer() {
+        static thread_local LineBuffer buffer;
+        return buffer;
+    }
+
+    static void write_line_buffer(LineBuffer &buffer) {
+        /*
+          We copy the line before locking the mutex, so that we never
+          allocate memory while holding it. Otherwise, the out-of-memory
+          handler could run while the mutex is locked.
+        */
+        std::string line = buffer.stream.str();
+        buffer.stream.str("");
+        static std::mutex log_mutex;
+        std::lock_guard<std::mutex> lock(log_mutex);
+        std::cout << line << std::flush;
+    }
+
+    template<typename T>
+    static bool ends_with_newline(const T &) {
+        return false;
+    }
+
+    static bool ends_with_newline(char c) {
+        return c == '\n';
+    }
+
+    static bool ends_with_newline(const char *str) {
+        std::size_t length = std::strlen(str);
+        return length > 0 && str[length - 1] == '\n';
+    }
+
+    static bool ends_with_newline(const std::string &str) {
+        return !str.empty() && str.back() == '\n';
+    }
 
 public:
     template<typename T>
     Log &operator<<(const T &elem) {
-        if (!line_has_started) {
-            line_has_started = true;
-            std::cout << "[t=" << g_timer << ", "
-                      << get_peak_memory_in_kb() << " KB] ";
+        LineBuffer &buffer = get_line_buffer();
+        if (!buffer.line_has_started) {
+            buffer.line_has_started = true;
+            buffer.stream << "[t=" << g_timer << ", "
+                          << get_peak_memory_in_kb() << " KB] ";
         }
 
-        std::cout << elem;
+        buffer.stream << elem;
+        if (ends_with_newline(elem)) {
+            write_line_buffer(buffer);
+        }
         return *this;
     }
 
     using manip_function = std::ostream &(*)(std::ostream &);
     Log &operator<<(manip_function f) {
+        LineBuffer &buffer = get_line_buffer();
         if (f == static_cast<manip_function>(&std::endl)) {
-            line_has_started = false;
+            buffer.line_has_started = false;
         }
 
-        std::cout << f;
+        buffer.stream << f;
+        write_line_buffer(buffer);
         return *this;
     }
 };
@@ -1,38 +1,54 @@
 #include "memory.h"
 
-#include "../utils/logging.h"
-
 #include <cassert>
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
 namespace utils {
+// Protects the padding against concurrent releases from several threads.
+static mutex extra_memory_padding_mutex;
 static char *extra_memory_padding = nullptr;
 
 // Save standard out-of-memory handler.
 static void (*standard_out_of_memory_handler)() = nullptr;
 
+// Return true if the padding was reserved before the call.
+static bool release_extra_memory_padding_if_reserved() {
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
+    if (!extra_memory_padding)
+        return false;
+    delete[] extra_memory_padding;
+    extra_memory_padding = nullptr;
+    assert(standard_out_of_memory_handler);
+    set_new_handler(standard_out_of_memory_handler);
+    return true;
+}
+
 void continuing_out_of_memory_handler() {
-    release_extra_memory_padding();
-    utils::g_log << "Failed to allocate memory. Released extra memory padding." << endl;
+    /*
+      If another thread released the padding in the meantime, we simply
+      let the allocation try again. We do not use g_log here because the
+      handler may run while the logger holds its lock.
+    */
+    if (release_extra_memory_padding_if_reserved())
+        cout << "Failed to allocate memory. Released extra memory padding." << endl;
 }
 
 void reserve_extra_memory_padding(int memory_in_mb) {
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
     assert(!extra_memory_padding);
     extra_memory_padding = new char[memory_in_mb * 1024 * 1024];
     standard_out_of_memory_handler = set_new_handler(continuing_out_of_memory_handler);
 }
 
 void release_extra_memory_padding() {
-    assert(extra_memory_padding);
-    delete[] extra_memory_padding;
-    extra_memory_padding = nullptr;
-    assert(standard_out_of_memory_handler);
-    set_new_handler(standard_out_of_memory_handler);
+    release_extra_memory_padding_if_reserved();
 }
 
 bool extra_memory_padding_is_reserved() {
+    lock_guard<mutex> lock(extra_memory_padding_mutex);
     return extra_memory_padding;
 }
 }
@@ -24,6 +24,9 @@ std::unique_ptr<T> make_unique_ptr(Args && ... args) {
 
   The interface assumes a single user. It is not possible for two parts
   of the planner to reserve extra memory padding at the same time.
+  However, several threads of that user may run out of memory at the same
+  time: the padding is released exactly once and releasing it again has
+  no effect.
 */
 extern void reserve_extra_memory_padding(int memory_in_mb);
 extern void release_extra_memory_padding();
@@ -0,0 +1,161 @@
+#include "profiling.h"
+
+#include "logging.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+using namespace std;
+
+namespace utils {
+namespace {
+struct ProfilingRegistry {
+    mutex registry_mutex;
+    vector<unique_ptr<ProfilingCounter>> counters;
+    // Profiles of running threads and merged data of finished threads.
+    vector<const ThreadProfile *> thread_profiles;
+    vector<ProfilingData> finished_threads_data;
+    /*
+      The cycle counter does not tick in seconds, so we relate the
+      cycles and the wall-clock time that passed since the registry
+      was created to convert cycles into seconds.
+    */
+    const chrono::steady_clock::time_point start_time;
+    const uint64_t start_cycles;
+
+    ProfilingRegistry()
+        : start_time(chrono::steady_clock::now()),
+          start_cycles(read_cycle_counter()) {
+    }
+};
+
+ProfilingRegistry &get_registry() {
+    static ProfilingRegistry registry;
+    return registry;
+}
+
+void add_all(vector<ProfilingData> &data, const vector<ProfilingData> &other) {
+    if (other.size() > data.size()) {
+        data.resize(other.size());
+    }
+    for (size_t id = 0; id < other.size(); ++id) {
+        data[id].add(other[id]);
+    }
+}
+}
+
+void ProfilingData::add_sample(uint64_t cycles) {
+    ++num_sampled_calls;
+    sampled_cycles += cycles;
+    int bucket = 0;
+    while (cycles > 1 && bucket < PROFILING_NUM_BUCKETS - 1) {
+        cycles >>= 1;
+        ++bucket;
+    }
+    ++histogram[bucket];
+}
+
+void ProfilingData::add(const ProfilingData &other) {
+    num_calls += other.num_calls;
+    num_sampled_calls += other.num_sampled_calls;
+    sampled_cycles += other.sampled_cycles;
+    for (int bucket = 0; bucket < PROFILING_NUM_BUCKETS; ++bucket) {
+        histogram[bucket] += other.histogram[bucket];
+    }
+}
+
+double ProfilingData::get_estimated_cycles() const {
+    if (num_sampled_calls == 0) {
+        return 0;
+    }
+    return static_cast<double>(sampled_cycles) / num_sampled_calls * num_calls;
+}
+
+ThreadProfile::ThreadProfile() {
+    ProfilingRegistry &registry = get_registry();
+    lock_guard<mutex> lock(registry.registry_mutex);
+    registry.thread_profiles.push_back(this);
+}
+
+ThreadProfile::~ThreadProfile() {
+    ProfilingRegistry &registry = get_registry();
+    lock_guard<mutex> lock(registry.registry_mutex);
+    add_all(registry.finished_threads_data, data);
+    vector<const ThreadProfile *> &profiles = registry.thread_profiles;
+    profiles.erase(find(profiles.begin(), profiles.end(), this));
+}
+
+#ifdef USE_COMPONENT_PROFILING
+ProfilingCounter &register_profiling_counter(const string &name) {
+    ProfilingRegistry &registry = get_registry();
+    lock_guard<mutex> lock(registry.registry_mutex);
+    for (const unique_ptr<ProfilingCounter> &counter : registry.counters) {
+        if (counter->get_name() == name) {
+            return *counter;
+        }
+    }
+    int id = registry.counters.size();
+    registry.counters.push_back(make_unique_ptr<ProfilingCounter>(name, id));
+    return *registry.counters.back();
+}
+#endif
+
+void print_profile() {
+    ProfilingRegistry &registry = get_registry();
+    lock_guard<mutex> lock(registry.registry_mutex);
+    vector<ProfilingData> data = registry.finished_threads_data;
+    for (const ThreadProfile *profile : registry.thread_profiles) {
+        add_all(data, profile->get_all_data());
+    }
+    vector<int> ids;
+    for (size_t id = 0; id < data.size(); ++id) {
+        if (data[id].num_calls > 0) {
+            ids.push_back(id);
+        }
+    }
+    if (ids.empty()) {
+        return;
+    }
+    sort(ids.begin(), ids.end(),
+         [&data](int id1, int id2) {
+             return data[id1].get_estimated_cycles() >
+                    data[id2].get_estimated_cycles();
+         });
+
+    double elapsed_seconds = chrono::duration<double>(
+        chrono::steady_clock::now() - registry.start_time).count();
+    double elapsed_cycles = static_cast<double>(
+        read_cycle_counter() - registry.start_cycles);
+    double cycles_per_second =
+        elapsed_seconds > 0 ? elapsed_cycles / elapsed_seconds : 0;
+
+    utils::g_log << "Component profile (every " << PROFILING_SAMPLE_PERIOD
+                 << "th call measured, " << elapsed_seconds
+                 << "s wall-clock time since the first profiled call):" << endl;
+    for (int id : ids) {
+        const ProfilingCounter &counter = *registry.counters[id];
+        const ProfilingData &counter_data = data[id];
+        double cycles = counter_data.get_estimated_cycles();
+        double seconds = cycles_per_second > 0 ? cycles / cycles_per_second : 0;
+        utils::g_log << "  " << counter.get_name() << ": "
+                     << counter_data.num_calls << " calls, "
+                     << seconds << "s ("
+                     << round(1000 * seconds / max(elapsed_seconds, 1e-9)) / 10
+                     << "%), "
+                     << static_cast<int64_t>(cycles / counter_data.num_calls)
+                     << " cycles per call" << endl;
+
+        const array<int64_t, PROFILING_NUM_BUCKETS> &histogram =
+            counter_data.histogram;
+        utils::g_log << "    cycles per call:";
+        for (int bucket = 0; bucket < PROFILING_NUM_BUCKETS; ++bucket) {
+            if (histogram[bucket] > 0) {
+                utils::g_log << " [2^" << bucket << "]=" << histogram[bucket];
+            }
+        }
+        utils::g_log << endl;
+    }
+}
+}
@@ -0,0 +1,208 @@
+#ifndef UTILS_PROFILING_H
+#define UTILS_PROFILING_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define UTILS_PROFILING_HAS_RDTSC
+#endif
+
+/*
+  Low-overhead profiling of hot code paths such as evaluator calls and
+  successor generation.
+
+  The instrumentation is only compiled in if USE_COMPONENT_PROFILING is
+  defined (CMake option USE_COMPONENT_PROFILING). Otherwise the
+  PROFILE_SCOPE macros expand to nothing and the planner is unaffected.
+
+  Each profiled scope counts all of its calls, but only measures every
+  PROFILING_SAMPLE_PERIOD-th call with the cycle counter, so that even
+  scopes that take only a few hundred cycles are barely slowed down. The
+  total time of a scope is extrapolated from the sampled calls.
+  The time of a scope includes the time of all scopes nested in it,
+  e.g., the time of a sum evaluator includes that of its components.
+
+  Counts are kept in thread-local memory, so profiled scopes can be
+  entered concurrently from several threads without synchronization.
+  The counts of all threads are merged when the profile is printed,
+  which the planner does once after the top-level search has finished.
+
+  Usage:
+
+  void f() {
+      PROFILE_SCOPE("f");
+      ...
+  }
+
+  void g(const Evaluator *eval) {
+      // Use a counter that is registered once per evaluator object.
+      PROFILE_SCOPE_COUNTER(eval->get_profiling_counter());
+      ...
+  }
+*/
+
+namespace utils {
+const int PROFILING_SAMPLE_PERIOD = 16;
+static_assert((PROFILING_SAMPLE_PERIOD & (PROFILING_SAMPLE_PERIOD - 1)) == 0,
+              "sample period must be a power of 2");
+
+const int PROFILING_NUM_BUCKETS = 48;
+
+inline uint64_t read_cycle_counter() {
+#ifdef UTILS_PROFILING_HAS_RDTSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Measurements of one profiled scope.
+struct ProfilingData {
+    int64_t num_calls = 0;
+    int64_t num_sampled_calls = 0;
+    uint64_t sampled_cycles = 0;
+    // Bucket i counts sampled calls with [2^i, 2^(i+1)) cycles.
+    std::array<int64_t, PROFILING_NUM_BUCKETS> histogram {};
+
+    // Count a call and return true if it should be measured.
+    bool start_call() {
+        return (num_calls++ & (PROFILING_SAMPLE_PERIOD - 1)) == 0;
+    }
+
+    void add_sample(uint64_t cycles);
+    void add(const ProfilingData &other);
+
+    // Extrapolated number of cycles spent in all calls.
+    double get_estimated_cycles() const;
+};
+
+/*
+  Name and ID of a profiled scope. The measurements are stored per
+  thread (see ThreadProfile) and indexed by the ID.
+*/
+class ProfilingCounter {
+    const std::string name;
+    const int id;
+
+public:
+    ProfilingCounter(const std::string &name, int id)
+        : name(name), id(id) {
+    }
+
+    const std::string &get_name() const {
+        return name;
+    }
+
+    int get_id() const {
+        return id;
+    }
+};
+
+// Measurements of all counters in one thread.
+class ThreadProfile {
+    std::vector<ProfilingData> data;
+
+public:
+    ThreadProfile();
+    // Merges the measurements into the global profile.
+    ~ThreadProfile();
+
+    ThreadProfile(const ThreadProfile &) = delete;
+    ThreadProfile &operator=(const ThreadProfile &) = delete;
+
+    ProfilingData &get_data(int id) {
+        if (id >= static_cast<int>(data.size())) {
+            data.resize(id + 1);
+        }
+        return data[id];
+    }
+
+    const std::vector<ProfilingData> &get_all_data() const {
+        return data;
+    }
+};
+
+inline ThreadProfile &get_thread_profile() {
+    thread_local ThreadProfile profile;
+    return profile;
+}
+
+class ScopedProfilingTimer {
+    ThreadProfile &profile;
+    const int id;
+    const bool sampled;
+    const uint64_t start_cycles;
+public:
+    explicit ScopedProfilingTimer(const ProfilingCounter &counter)
+        : profile(get_thread_profile()),
+          id(counter.get_id()),
+          sampled(profile.get_data(id).start_call()),
+          start_cycles(sampled ? read_cycle_counter() : 0) {
+    }
+
+    ~ScopedProfilingTimer() {
+        if (sampled) {
+            /*
+              Nested scopes may have resized the thread profile, so we
+              look up the data again instead of keeping a reference.
+            */
+            profile.get_data(id).add_sample(read_cycle_counter() - start_cycles);
+        }
+    }
+
+    ScopedProfilingTimer(const ScopedProfilingTimer &) = delete;
+    ScopedProfilingTimer &operator=(const ScopedProfilingTimer &) = delete;
+};
+
+/*
+  Return the counter with the given name, creating it if necessary. Counters
+  live until the end of the program, and objects with the same name (e.g.,
+  the evaluator copies of parallel search workers) share one counter.
+
+  Without USE_COMPONENT_PROFILING, all names share a dummy counter, so that
+  objects like evaluators do not pay for registering their counters.
+*/
+#ifdef USE_COMPONENT_PROFILING
+extern ProfilingCounter &register_profiling_counter(const std::string &name);
+#else
+inline ProfilingCounter &register_profiling_counter(const std::string &) {
+    static ProfilingCounter dummy_counter("<profiling disabled>", 0);
+    return dummy_counter;
+}
+#endif
+
+/*
+  Print the call counts, estimated time and histogram of cycles per call
+  for all counters that have been called at least once. Prints nothing if
+  no counters have been called, i.e., if profiling is disabled.
+
+  The measurements of threads that are still running are read without
+  synchronization, so this should only be called while no other thread
+  enters profiled scopes.
+*/
+extern void print_profile();
+}
+
+#ifdef USE_COMPONENT_PROFILING
+#define PROFILE_SCOPE(name) \
+    static utils::ProfilingCounter &_profiling_counter = \
+        utils::register_profiling_counter(name); \
+    utils::ScopedProfilingTimer _profiling_timer(_profiling_counter)
+#define PROFILE_SCOPE_COUNTER(counter) \
+    utils::ScopedProfilingTimer _profiling_timer(counter)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_SCOPE_COUNTER(counter)
+#endif
+
+#endif
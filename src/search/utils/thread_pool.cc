@@ -0,0 +1,94 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : num_unfinished_jobs(0),
+      stopping(false) {
+    assert(num_threads >= 1);
+    if (num_threads > 1) {
+        workers.reserve(num_threads);
+        for (int i = 0; i < num_threads; ++i)
+            workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_available.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::work() {
+    while (true) {
+        function<void()> job;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            job_available.wait(lock, [this]() {
+                                   return stopping || !jobs.empty();
+                               });
+            if (jobs.empty())
+                return;
+            job = move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+        {
+            lock_guard<std::mutex> lock(mutex);
+            --num_unfinished_jobs;
+            if (num_unfinished_jobs == 0)
+                all_jobs_done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::submit(function<void()> job) {
+    if (workers.empty()) {
+        job();
+        return;
+    }
+    {
+        lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(move(job));
+        ++num_unfinished_jobs;
+    }
+    job_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<std::mutex> lock(mutex);
+    all_jobs_done.wait(lock, [this]() {
+                           return num_unfinished_jobs == 0;
+                       });
+}
+
+void ThreadPool::parallel_for(
+    int num_items, const function<void(int, int)> &process_chunk,
+    int min_chunk_size) {
+    if (num_items <= 0)
+        return;
+    int num_threads = get_num_threads();
+    if (num_threads == 1 || num_items <= min_chunk_size) {
+        process_chunk(0, num_items);
+        return;
+    }
+    // Use a few chunks per thread to balance uneven work.
+    int num_chunks = min(4 * num_threads, max(1, num_items / min_chunk_size));
+    int chunk_size = (num_items + num_chunks - 1) / num_chunks;
+    for (int begin = 0; begin < num_items; begin += chunk_size) {
+        int end = min(num_items, begin + chunk_size);
+        submit([&process_chunk, begin, end]() {
+                   process_chunk(begin, end);
+               });
+    }
+    wait();
+}
+}
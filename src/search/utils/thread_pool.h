@@ -0,0 +1,66 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed set of worker threads that execute submitted jobs.
+
+  With a single thread, no worker threads are started and jobs run
+  directly in the calling thread, so code can use a pool unconditionally
+  without paying for threads in the sequential case.
+
+  Jobs must not submit jobs themselves and wait for them, since all
+  workers could then be blocked waiting.
+
+  Usage:
+
+  ThreadPool pool(4);
+  pool.parallel_for(num_items, [&](int begin, int end) {
+          for (int i = begin; i < end; ++i)
+              process(i);
+      });
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable job_available;
+    std::condition_variable all_jobs_done;
+    std::deque<std::function<void()>> jobs;
+    int num_unfinished_jobs;
+    bool stopping;
+
+    void work();
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    int get_num_threads() const {
+        return workers.empty() ? 1 : workers.size();
+    }
+
+    void submit(std::function<void()> job);
+
+    // Block until all submitted jobs have finished.
+    void wait();
+
+    /*
+      Split [0, num_items) into contiguous chunks, call
+      process_chunk(begin, end) for each chunk in parallel and wait for
+      all of them. Each chunk contains at least min_chunk_size items
+      (except possibly the last one).
+    */
+    void parallel_for(
+        int num_items,
+        const std::function<void(int begin, int end)> &process_chunk,
+        int min_chunk_size = 1);
+};
+}
+
+#endif